@@ -0,0 +1,751 @@
+/* SPDX-FileCopyrightText: 2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* Headless benchmark of a fixed set of scenes, reporting the time spent in every stage of the
+ * scene update and rendering as JSON, and comparing the results against a previous run to catch
+ * performance regressions. */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "device/device.h"
+#include "scene/camera.h"
+#include "scene/integrator.h"
+#include "scene/light.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/pass.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+#include "scene/shader_graph.h"
+#include "scene/shader_nodes.h"
+#include "scene/stats.h"
+#include "session/buffers.h"
+#include "session/session.h"
+
+#include "util/args.h"
+#include "util/foreach.h"
+#include "util/function.h"
+#include "util/guarded_allocator.h"
+#include "util/json.h"
+#include "util/log.h"
+#include "util/map.h"
+#include "util/path.h"
+#include "util/string.h"
+#include "util/time.h"
+#include "util/transform.h"
+#include "util/unique_ptr.h"
+#include "util/vector.h"
+#include "util/version.h"
+
+#include "app/cycles_xml.h"
+
+CCL_NAMESPACE_BEGIN
+
+struct BenchmarkScene {
+  string name;
+  /* Fills the empty scene, either by reading a file or by generating it. */
+  function<void(Scene *scene)> build;
+};
+
+/* Metrics of a single scene, in the order they are written. Names starting with `time_` are in
+ * seconds and names starting with `mem_` in bytes, lower is better for both. Higher is better for
+ * names ending with `_per_second`. */
+struct BenchmarkResult {
+  string name;
+  string error;
+  vector<pair<string, double>> metrics;
+};
+
+typedef map<string, map<string, double>> BenchmarkBaseline;
+
+struct Options {
+  vector<string> filepaths;
+  int width, height;
+  int repeat;
+  bool use_synthetic;
+  bool use_denoise;
+  float threshold;
+  float min_time;
+  string output_filepath;
+  string baseline_filepath;
+  SceneParams scene_params;
+  SessionParams session_params;
+} options;
+
+/* Synthetic Scenes */
+
+static Shader *add_diffuse_shader(Scene *scene, const string &name, const float3 color)
+{
+  ShaderGraph *graph = new ShaderGraph();
+
+  DiffuseBsdfNode *diffuse = graph->create_node<DiffuseBsdfNode>();
+  diffuse->set_color(color);
+  graph->add(diffuse);
+
+  graph->connect(diffuse->output("BSDF"), graph->output()->input("Surface"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->name = name;
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+  return shader;
+}
+
+static Shader *add_emission_shader(Scene *scene, const string &name)
+{
+  ShaderGraph *graph = new ShaderGraph();
+
+  EmissionNode *emission = graph->create_node<EmissionNode>();
+  emission->set_color(one_float3());
+  emission->set_strength(1.0f);
+  graph->add(emission);
+
+  graph->connect(emission->output("Emission"), graph->output()->input("Surface"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->name = name;
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+  return shader;
+}
+
+static void add_object(Scene *scene, Geometry *geometry, const Transform &tfm)
+{
+  Object *object = scene->create_node<Object>();
+  object->set_geometry(geometry);
+  object->set_tfm(tfm);
+}
+
+/* Regular grid in the XY plane, centered at the origin. */
+static Mesh *add_grid_mesh(Scene *scene, Shader *shader, const int resolution, const float size)
+{
+  Mesh *mesh = scene->create_node<Mesh>();
+
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(shader);
+  mesh->set_used_shaders(used_shaders);
+
+  const int num_verts_side = resolution + 1;
+  mesh->reserve_mesh(num_verts_side * num_verts_side, resolution * resolution * 2);
+
+  array<float3> verts;
+  verts.reserve(num_verts_side * num_verts_side);
+  for (int y = 0; y < num_verts_side; y++) {
+    for (int x = 0; x < num_verts_side; x++) {
+      verts.push_back_reserved(make_float3(((float)x / resolution - 0.5f) * size,
+                                           ((float)y / resolution - 0.5f) * size,
+                                           0.0f));
+    }
+  }
+  mesh->set_verts(verts);
+
+  for (int y = 0; y < resolution; y++) {
+    for (int x = 0; x < resolution; x++) {
+      const int v0 = y * num_verts_side + x;
+      const int v1 = v0 + 1;
+      const int v2 = v0 + num_verts_side + 1;
+      const int v3 = v0 + num_verts_side;
+      mesh->add_triangle(v0, v1, v2, 0, false);
+      mesh->add_triangle(v0, v2, v3, 0, false);
+    }
+  }
+
+  return mesh;
+}
+
+static Mesh *add_sphere_mesh(Scene *scene, Shader *shader, const int segments, const int rings)
+{
+  Mesh *mesh = scene->create_node<Mesh>();
+
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(shader);
+  mesh->set_used_shaders(used_shaders);
+
+  const int num_verts = (rings + 1) * segments;
+  mesh->reserve_mesh(num_verts, rings * segments * 2);
+
+  array<float3> verts;
+  verts.reserve(num_verts);
+  for (int ring = 0; ring <= rings; ring++) {
+    const float theta = M_PI_F * ring / rings;
+    for (int segment = 0; segment < segments; segment++) {
+      const float phi = M_2PI_F * segment / segments;
+      verts.push_back_reserved(
+          make_float3(sinf(theta) * cosf(phi), sinf(theta) * sinf(phi), cosf(theta)));
+    }
+  }
+  mesh->set_verts(verts);
+
+  for (int ring = 0; ring < rings; ring++) {
+    for (int segment = 0; segment < segments; segment++) {
+      const int next_segment = (segment + 1) % segments;
+      const int v0 = ring * segments + segment;
+      const int v1 = ring * segments + next_segment;
+      const int v2 = v1 + segments;
+      const int v3 = v0 + segments;
+      mesh->add_triangle(v0, v1, v2, 0, true);
+      mesh->add_triangle(v0, v2, v3, 0, true);
+    }
+  }
+
+  return mesh;
+}
+
+static void add_point_light(Scene *scene, Shader *shader, const float3 co, const float3 strength)
+{
+  Light *light = scene->create_node<Light>();
+  light->set_light_type(LIGHT_POINT);
+  light->set_shader(shader);
+  light->set_strength(strength);
+  light->set_size(0.1f);
+  light->set_tfm(transform_translate(co));
+}
+
+/* Camera looking at the origin along the Z axis. */
+static void add_camera(Scene *scene, const float distance)
+{
+  scene->camera->set_matrix(transform_translate(make_float3(0.0f, 0.0f, -distance)));
+}
+
+/* Many instances of a small mesh, with a few distinct materials that are duplicated many times.
+ * Mostly measures object and BVH updates and shader compilation. */
+static void build_instances_scene(Scene *scene)
+{
+  Mesh *sphere = add_sphere_mesh(scene, scene->default_surface, 32, 16);
+
+  vector<Shader *> shaders;
+  for (int i = 0; i < 16; i++) {
+    const float3 color = make_float3((i % 4) * 0.25f, 0.5f, 0.8f - (i % 4) * 0.2f);
+    shaders.push_back(add_diffuse_shader(scene, string_printf("material_%d", i), color));
+  }
+
+  const int grid_size = 32;
+  for (int y = 0; y < grid_size; y++) {
+    for (int x = 0; x < grid_size; x++) {
+      const float3 co = make_float3((x - grid_size / 2) * 0.5f, (y - grid_size / 2) * 0.5f, 0.0f);
+      add_object(scene, sphere, transform_translate(co) * transform_scale(0.2f, 0.2f, 0.2f));
+    }
+  }
+
+  /* Also reference the materials from actual geometry, so they are compiled. */
+  for (size_t i = 0; i < shaders.size(); i++) {
+    Mesh *mesh = add_sphere_mesh(scene, shaders[i], 16, 8);
+    add_object(scene, mesh, transform_translate(make_float3(-4.0f + i * 0.5f, -6.0f, 0.0f)));
+  }
+
+  add_point_light(scene,
+                  add_emission_shader(scene, "light"),
+                  make_float3(0.0f, 0.0f, -6.0f),
+                  make_float3(200.0f, 200.0f, 200.0f));
+  add_camera(scene, 16.0f);
+}
+
+/* A single mesh with millions of triangles. Mostly measures geometry upload and BVH build. */
+static void build_dense_mesh_scene(Scene *scene)
+{
+  Mesh *mesh = add_grid_mesh(scene, scene->default_surface, 1024, 8.0f);
+  add_object(scene, mesh, transform_identity());
+
+  add_point_light(scene,
+                  add_emission_shader(scene, "light"),
+                  make_float3(0.0f, 0.0f, -4.0f),
+                  make_float3(100.0f, 100.0f, 100.0f));
+  add_camera(scene, 8.0f);
+}
+
+/* Thousands of small lights above a plane. Mostly measures light tree build and light
+ * sampling. */
+static void build_many_lights_scene(Scene *scene)
+{
+  Mesh *mesh = add_grid_mesh(scene, scene->default_surface, 16, 16.0f);
+  add_object(scene, mesh, transform_identity());
+
+  Shader *shader = add_emission_shader(scene, "light");
+
+  const int grid_size = 64;
+  for (int y = 0; y < grid_size; y++) {
+    for (int x = 0; x < grid_size; x++) {
+      const float3 co = make_float3(
+          (x - grid_size / 2) * 0.25f, (y - grid_size / 2) * 0.25f, -0.2f - (x % 4) * 0.1f);
+      const float3 strength = make_float3(1.0f + (x % 3), 1.0f + (y % 3), 1.0f + ((x + y) % 3));
+      add_point_light(scene, shader, co, strength);
+    }
+  }
+
+  add_camera(scene, 12.0f);
+}
+
+/* Benchmark */
+
+static double update_stats_time(const UpdateTimeStats &stats, const char *name_filter)
+{
+  double time = 0.0;
+  foreach (const NamedTimeEntry &entry, stats.times.entries) {
+    if (entry.name.find(name_filter) != string::npos) {
+      time += entry.time;
+    }
+  }
+  return time;
+}
+
+static bool render_scene(const BenchmarkScene &bench, BenchmarkResult &result)
+{
+  unique_ptr<Session> session = make_unique<Session>(options.session_params,
+                                                     options.scene_params);
+  Scene *scene = session->scene;
+  scene->enable_update_stats();
+
+  const double time_load_start = time_dt();
+  bench.build(scene);
+  const double time_load = time_dt() - time_load_start;
+
+  if (!(options.width == 0 || options.height == 0)) {
+    scene->camera->set_full_width(options.width);
+    scene->camera->set_full_height(options.height);
+  }
+  scene->camera->compute_auto_viewplane();
+
+  if (options.use_denoise) {
+    scene->integrator->set_use_denoise(true);
+    scene->integrator->set_denoiser_type(DENOISER_OPENIMAGEDENOISE);
+  }
+
+  Pass *pass = scene->create_node<Pass>();
+  pass->set_name(ustring("combined"));
+  pass->set_type(PASS_COMBINED);
+
+  BufferParams buffer_params;
+  buffer_params.width = scene->camera->get_full_width();
+  buffer_params.height = scene->camera->get_full_height();
+  buffer_params.full_width = buffer_params.width;
+  buffer_params.full_height = buffer_params.height;
+
+  const double time_render_start = time_dt();
+  session->reset(options.session_params, buffer_params);
+  session->start();
+  session->wait();
+  const double time_total = time_dt() - time_render_start;
+
+  if (session->progress.get_error()) {
+    result.error = session->progress.get_error_message();
+    return false;
+  }
+
+  const SceneUpdateStats &stats = *scene->update_stats;
+  const RenderScheduler::WorkTimes work_times = session->get_render_work_times();
+  const double time_render = work_times.path_trace + work_times.adaptive_filter;
+  const int num_samples = session->get_num_rendered_samples();
+  const double num_pixels = (double)buffer_params.width * buffer_params.height;
+
+  result.metrics = {
+      {"time_scene_load", time_load},
+      {"time_scene_update", stats.scene.times.total_time},
+      {"time_geometry", stats.geometry.times.total_time},
+      {"time_bvh", update_stats_time(stats.geometry, "BVH")},
+      {"time_object", stats.object.times.total_time},
+      {"time_light", stats.light.times.total_time},
+      {"time_image", stats.image.times.total_time},
+      {"time_shader", stats.svm.times.total_time + stats.osl.times.total_time},
+      {"time_render", time_render},
+      {"time_denoise", work_times.denoise},
+      {"time_total", time_total},
+      {"samples", (double)num_samples},
+      {"samples_per_second", (time_render > 0.0) ? num_samples / time_render : 0.0},
+      {"pixel_samples_per_second",
+       (time_render > 0.0) ? num_samples * num_pixels / time_render : 0.0},
+      {"mem_device_peak", (double)session->stats.mem_peak},
+      /* Peak of the whole process so far, so it depends on the scenes that were rendered
+       * before this one. Only informative, see #is_compared_metric. */
+      {"mem_host_peak", (double)util_guarded_get_mem_peak()},
+  };
+
+  return true;
+}
+
+static double result_metric(const BenchmarkResult &result, const string &metric)
+{
+  foreach (const auto &value, result.metrics) {
+    if (value.first == metric) {
+      return value.second;
+    }
+  }
+  return 0.0;
+}
+
+static bool is_time_metric(const string &metric)
+{
+  return string_startswith(metric, "time_");
+}
+
+static bool is_higher_better_metric(const string &metric)
+{
+  return string_endswith(metric, "_per_second");
+}
+
+/* Metrics which don't describe the performance of a single scene are not checked for
+ * regressions. */
+static bool is_compared_metric(const string &metric)
+{
+  return !(metric == "samples" || metric == "mem_host_peak");
+}
+
+/* Keep the best value of every metric over repeated runs, to reduce the influence of noise. */
+static void merge_best_result(BenchmarkResult &best, const BenchmarkResult &result)
+{
+  if (best.metrics.empty()) {
+    best.metrics = result.metrics;
+    return;
+  }
+
+  for (size_t i = 0; i < best.metrics.size(); i++) {
+    const string &metric = best.metrics[i].first;
+    const double value = result.metrics[i].second;
+    if (metric == "samples") {
+      continue;
+    }
+    double &best_value = best.metrics[i].second;
+    best_value = (is_higher_better_metric(metric)) ? max(best_value, value) :
+                                                     min(best_value, value);
+  }
+}
+
+/* JSON */
+
+static string results_to_json(const vector<BenchmarkResult> &results)
+{
+  JSONWriter writer;
+  writer.begin_object();
+  writer.key("version");
+  writer.value(CYCLES_VERSION_STRING);
+  writer.key("device");
+  writer.value(options.session_params.device.description);
+  writer.key("threads");
+  writer.value(options.session_params.threads);
+  writer.key("repeat");
+  writer.value(options.repeat);
+
+  writer.key("scenes");
+  writer.begin_object();
+  foreach (const BenchmarkResult &result, results) {
+    writer.key(result.name);
+    writer.begin_object();
+    if (!result.error.empty()) {
+      writer.key("error");
+      writer.value(result.error);
+    }
+    foreach (const auto &metric, result.metrics) {
+      writer.key(metric.first);
+      writer.value(metric.second);
+    }
+    writer.end_object();
+  }
+  writer.end_object();
+
+  writer.end_object();
+  return writer.get_string();
+}
+
+/* Read the metrics of all scenes from the results of a previous run. */
+static bool read_baseline(const string &text, BenchmarkBaseline &r_baseline)
+{
+  JSONReader reader(text);
+  const bool success = reader.read_object([&](const string &key) {
+    if (key != "scenes") {
+      return reader.skip_value();
+    }
+    return reader.read_object([&](const string &scene_name) {
+      map<string, double> &metrics = r_baseline[scene_name];
+      return reader.read_object([&](const string &metric) {
+        const char c = reader.peek();
+        if (!(c == '-' || isdigit((unsigned char)c))) {
+          /* Error messages and metrics that could not be measured. */
+          return reader.skip_value();
+        }
+        return reader.read_number(metrics[metric]);
+      });
+    });
+  });
+  return success && reader.at_end();
+}
+
+/* Print the metrics that got worse than the baseline by more than the threshold, and return the
+ * number of regressions. */
+static int compare_with_baseline(const vector<BenchmarkResult> &results,
+                                 const BenchmarkBaseline &baseline)
+{
+  int num_regressions = 0;
+
+  foreach (const BenchmarkResult &result, results) {
+    const auto baseline_scene = baseline.find(result.name);
+    if (baseline_scene == baseline.end()) {
+      printf("%s: not in baseline\n", result.name.c_str());
+      continue;
+    }
+
+    foreach (const auto &metric, result.metrics) {
+      const auto baseline_metric = baseline_scene->second.find(metric.first);
+      if (baseline_metric == baseline_scene->second.end() || !is_compared_metric(metric.first)) {
+        continue;
+      }
+
+      const double base = baseline_metric->second;
+      const double value = metric.second;
+      bool is_regression;
+      if (is_higher_better_metric(metric.first)) {
+        is_regression = value * (1.0 + options.threshold) < base;
+      }
+      else {
+        is_regression = value > base * (1.0 + options.threshold);
+        /* Very short stages are dominated by noise. */
+        if (is_time_metric(metric.first) && value - base < options.min_time) {
+          is_regression = false;
+        }
+      }
+
+      if (is_regression) {
+        printf("%s: %s regressed from %g to %g (%+.1f%%)\n",
+               result.name.c_str(),
+               metric.first.c_str(),
+               base,
+               value,
+               (base != 0.0) ? (value / base - 1.0) * 100.0 : 0.0);
+        num_regressions++;
+      }
+    }
+  }
+
+  return num_regressions;
+}
+
+/* Options */
+
+static int files_parse(int argc, const char *argv[])
+{
+  if (argc > 0) {
+    options.filepaths.push_back(argv[0]);
+  }
+
+  return 0;
+}
+
+static void options_parse(int argc, const char **argv)
+{
+  options.width = 512;
+  options.height = 256;
+  options.repeat = 1;
+  options.use_synthetic = true;
+  options.use_denoise = false;
+  options.threshold = 0.1f;
+  options.min_time = 0.01f;
+  options.output_filepath = "cycles_benchmark.json";
+  options.session_params.background = true;
+  options.session_params.headless = true;
+  options.session_params.samples = 16;
+  options.session_params.use_auto_tile = false;
+
+  string devicename = "CPU";
+  bool no_synthetic = false;
+
+  /* parse options */
+  ArgParse ap;
+  bool help = false, debug = false, version = false;
+  int verbosity = 1;
+
+  ap.options("Usage: cycles_benchmark [options] [file.xml ...]",
+             "%*",
+             files_parse,
+             "",
+             "--device %s",
+             &devicename,
+             "Device to use, only CPU gives comparable memory statistics",
+             "--samples %d",
+             &options.session_params.samples,
+             "Number of samples to render",
+             "--threads %d",
+             &options.session_params.threads,
+             "CPU Rendering Threads",
+             "--width %d",
+             &options.width,
+             "Image width in pixels, 0 to use the resolution of the scene",
+             "--height %d",
+             &options.height,
+             "Image height in pixels, 0 to use the resolution of the scene",
+             "--repeat %d",
+             &options.repeat,
+             "Number of times to render every scene, keeping the best result",
+             "--denoise",
+             &options.use_denoise,
+             "Denoise the render result",
+             "--no-synthetic",
+             &no_synthetic,
+             "Only render the given files, not the built-in synthetic scenes",
+             "--output %s",
+             &options.output_filepath,
+             "File path to write the JSON results to",
+             "--baseline %s",
+             &options.baseline_filepath,
+             "JSON results of a previous run to compare against",
+             "--threshold %f",
+             &options.threshold,
+             "Relative change that is considered a regression (default 0.1)",
+             "--min-time %f",
+             &options.min_time,
+             "Smallest increase in seconds that is considered a regression (default 0.01)",
+#ifdef WITH_CYCLES_LOGGING
+             "--debug",
+             &debug,
+             "Enable debug logging",
+             "--verbose %d",
+             &verbosity,
+             "Set verbosity of the logger",
+#endif
+             "--help",
+             &help,
+             "Print help message",
+             "--version",
+             &version,
+             "Print version number",
+             NULL);
+
+  if (ap.parse(argc, argv) < 0) {
+    fprintf(stderr, "%s\n", ap.geterror().c_str());
+    ap.usage();
+    exit(EXIT_FAILURE);
+  }
+
+  if (debug) {
+    util_logging_start();
+    util_logging_verbosity_set(verbosity);
+  }
+
+  if (version) {
+    printf("%s\n", CYCLES_VERSION_STRING);
+    exit(EXIT_SUCCESS);
+  }
+  else if (help) {
+    ap.usage();
+    exit(EXIT_SUCCESS);
+  }
+
+  options.use_synthetic = !no_synthetic;
+
+  /* find matching device */
+  DeviceType device_type = Device::type_from_string(devicename.c_str());
+  vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK(device_type));
+
+  if (devices.empty()) {
+    fprintf(stderr, "Unknown device: %s\n", devicename.c_str());
+    exit(EXIT_FAILURE);
+  }
+  options.session_params.device = devices.front();
+
+  if (options.use_denoise) {
+    if (!(options.session_params.device.denoisers & DENOISER_OPENIMAGEDENOISE)) {
+      fprintf(stderr, "Denoising is not supported on device: %s\n", devicename.c_str());
+      exit(EXIT_FAILURE);
+    }
+    options.session_params.denoise_device = options.session_params.device;
+  }
+
+  if (options.session_params.samples <= 0) {
+    fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.repeat <= 0) {
+    fprintf(stderr, "Invalid number of repetitions: %d\n", options.repeat);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.filepaths.empty() && !options.use_synthetic) {
+    fprintf(stderr, "No scenes to render\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static vector<BenchmarkScene> benchmark_scenes()
+{
+  vector<BenchmarkScene> scenes;
+
+  if (options.use_synthetic) {
+    scenes.push_back({"synthetic_instances", build_instances_scene});
+    scenes.push_back({"synthetic_dense_mesh", build_dense_mesh_scene});
+    scenes.push_back({"synthetic_many_lights", build_many_lights_scene});
+  }
+
+  foreach (const string &filepath, options.filepaths) {
+    scenes.push_back({path_filename(filepath), [filepath](Scene *scene) {
+                        xml_read_file(scene, filepath.c_str());
+                      }});
+  }
+
+  return scenes;
+}
+
+CCL_NAMESPACE_END
+
+using namespace ccl;
+
+int main(int argc, const char **argv)
+{
+  util_logging_init(argv[0]);
+  path_init();
+  options_parse(argc, argv);
+
+  BenchmarkBaseline baseline;
+  if (!options.baseline_filepath.empty()) {
+    string text;
+    if (!path_read_text(options.baseline_filepath, text) || !read_baseline(text, baseline))
+    {
+      fprintf(stderr, "Failed to read baseline \"%s\"\n", options.baseline_filepath.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  vector<BenchmarkResult> results;
+  bool success = true;
+
+  foreach (const BenchmarkScene &bench, benchmark_scenes()) {
+    BenchmarkResult best;
+    best.name = bench.name;
+
+    for (int i = 0; i < options.repeat; i++) {
+      BenchmarkResult result;
+      if (!render_scene(bench, result)) {
+        fprintf(stderr, "%s: %s\n", bench.name.c_str(), result.error.c_str());
+        best.error = result.error;
+        success = false;
+        break;
+      }
+      merge_best_result(best, result);
+    }
+
+    if (best.error.empty()) {
+      printf("%s: %.3f seconds total, %.3f seconds render\n",
+             best.name.c_str(),
+             result_metric(best, "time_total"),
+             result_metric(best, "time_render"));
+    }
+    results.push_back(best);
+  }
+
+  string json = results_to_json(results);
+  if (!path_write_text(options.output_filepath, json)) {
+    fprintf(stderr, "Failed to write results to \"%s\"\n", options.output_filepath.c_str());
+    return EXIT_FAILURE;
+  }
+  printf("Results written to \"%s\"\n", options.output_filepath.c_str());
+
+  if (!options.baseline_filepath.empty()) {
+    const int num_regressions = compare_with_baseline(results, baseline);
+    printf("%d regressions compared to \"%s\"\n",
+           num_regressions,
+           options.baseline_filepath.c_str());
+    if (num_regressions) {
+      success = false;
+    }
+  }
+
+  return (success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
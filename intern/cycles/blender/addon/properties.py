@@ -913,6 +913,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use compact BVH structure (uses less ram but renders slower)",
         default=False,
     )
+    debug_use_bvh_refit: BoolProperty(
+        name="Refit BVH",
+        description="Refit the BVH of deforming objects instead of rebuilding it, which makes "
+        "updates of animated scenes faster but may render slower",
+        default=False,
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -1040,6 +1046,41 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_tile_streaming: BoolProperty(
+        name="Stream Tiles",
+        description="Denoise and output the result of tiled renders one tile at a time from the disk cache, instead of "
+                    "loading the full frame into memory. Lowers peak memory usage of very high resolution renders, "
+                    "but denoising may show faint seams between tiles",
+        default=False,
+    )
+
+    use_texture_cache: BoolProperty(
+        name="Texture Cache",
+        description="Read image textures on demand in tiles and at the resolution needed, instead of loading them fully into memory. "
+                    "Only used for CPU rendering with SVM, works best with tiled and mipmapped .tx files",
+        default=False,
+    )
+    texture_cache_size: IntProperty(
+        name="Cache Size",
+        description="Maximum amount of memory used by the texture cache in megabytes",
+        default=4096,
+        min=64, max=1048576,
+    )
+
+    use_attribute_quantization: BoolProperty(
+        name="Quantize Attributes",
+        description="Store attributes like UV maps, normals and colors of meshes with reduced precision when the error "
+                    "stays below the tolerance, to reduce memory usage",
+        default=False,
+    )
+    attribute_quantization_tolerance: FloatProperty(
+        name="Tolerance",
+        description="Maximum error of quantized attribute values. Attributes that can't be stored within this error keep "
+                    "full precision",
+        default=0.001,
+        min=0.0, soft_max=0.01,
+        precision=4,
+    )
 
     # Various fine-tuning debug flags
 
@@ -1050,6 +1091,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
 
     debug_use_cpu_avx2: BoolProperty(name="AVX2", default=True)
     debug_use_cpu_sse42: BoolProperty(name="SSE42", default=True)
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Render batches of paths one kernel at a time, grouped by shader, instead of tracing each path from start to end",
+        default=False,
+    )
     debug_bvh_layout: EnumProperty(
         name="BVH Layout",
         items=enum_bvh_layouts,
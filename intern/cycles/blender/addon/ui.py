@@ -833,6 +833,20 @@ class CYCLES_RENDER_PT_performance_memory(CyclesButtonsPanel, Panel):
         sub = col.column()
         sub.active = cscene.use_auto_tile
         sub.prop(cscene, "tile_size")
+        sub.prop(cscene, "use_tile_streaming")
+
+        col = layout.column()
+        col.active = use_cpu(context) and not cscene.shading_system
+        col.prop(cscene, "use_texture_cache")
+        sub = col.column()
+        sub.active = cscene.use_texture_cache
+        sub.prop(cscene, "texture_cache_size")
+
+        col = layout.column()
+        col.prop(cscene, "use_attribute_quantization")
+        sub = col.column()
+        sub.active = cscene.use_attribute_quantization
+        sub.prop(cscene, "attribute_quantization_tolerance")
 
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
@@ -861,6 +875,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
             col.prop(cscene, "debug_use_spatial_splits")
             if use_embree:
                 col.prop(cscene, "debug_use_compact_bvh")
+                col.prop(cscene, "debug_use_bvh_refit")
             else:
                 sub = col.column()
                 sub.active = not cscene.debug_use_spatial_splits
@@ -882,6 +897,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
             # CPU is used in addition to a GPU
             if use_multi_device(context) and use_embree:
                 col.prop(cscene, "debug_use_compact_bvh")
+                col.prop(cscene, "debug_use_bvh_refit")
 
 
 class CYCLES_RENDER_PT_performance_final_render(CyclesButtonsPanel, Panel):
@@ -2154,6 +2170,7 @@ class CYCLES_RENDER_PT_debug(CyclesDebugButtonsPanel, Panel):
         row.prop(cscene, "debug_use_cpu_sse42", toggle=True)
         row.prop(cscene, "debug_use_cpu_avx2", toggle=True)
         col.prop(cscene, "debug_bvh_layout", text="BVH")
+        col.prop(cscene, "debug_use_cpu_wavefront")
 
         col.separator()
 
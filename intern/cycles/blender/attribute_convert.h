@@ -96,6 +96,14 @@ template<> struct AttributeConverter<blender::math::Quaternion> {
   }
 };
 
+/* Blender types with the same memory layout as their Cycles type, so that their arrays can be
+ * shared with Cycles without conversion. The alignment of the array must still be checked, as
+ * Cycles vector types may require a larger alignment than the Blender type. */
+template<typename BlenderT> constexpr bool attribute_layout_matches = false;
+template<> constexpr bool attribute_layout_matches<float> = true;
+template<> constexpr bool attribute_layout_matches<blender::float2> = true;
+template<> constexpr bool attribute_layout_matches<blender::ColorGeometry4f> = true;
+
 CCL_NAMESPACE_END
 
 #endif /* __BLENDER_ATTRIBUTE_CONVERT_H__ */
@@ -267,6 +267,49 @@ static void attr_create_motion_from_velocity(Mesh *mesh,
   }
 }
 
+/* Keeps an implicitly shared Blender array alive while Cycles uses it. */
+class BlenderAttributeSharedData : public AttributeSharedData {
+ public:
+  explicit BlenderAttributeSharedData(const blender::ImplicitSharingInfo *sharing_info)
+      : sharing_info_(sharing_info)
+  {
+    sharing_info_->add_user();
+  }
+
+  ~BlenderAttributeSharedData() override
+  {
+    sharing_info_->remove_user_and_delete_if_last();
+  }
+
+ private:
+  const blender::ImplicitSharingInfo *sharing_info_;
+};
+
+/* Reference the Blender attribute array from the Cycles attribute instead of copying it, when it
+ * is stored in the same format and layout. Returns false if the data has to be converted. */
+template<typename BlenderT>
+static bool attr_share_generic(Attribute *attr, const blender::bke::GAttributeReader &b_attr)
+{
+  using CyclesT = typename AttributeConverter<BlenderT>::CyclesT;
+  if constexpr (!attribute_layout_matches<BlenderT>) {
+    return false;
+  }
+  else {
+    static_assert(sizeof(BlenderT) == sizeof(CyclesT));
+    if (b_attr.sharing_info == nullptr || !b_attr.varray.is_span()) {
+      return false;
+    }
+    const blender::GSpan span = b_attr.varray.get_internal_span();
+    if (reinterpret_cast<uintptr_t>(span.data()) % alignof(CyclesT) != 0) {
+      return false;
+    }
+    attr->set_shared_data(span.data(),
+                          span.size_in_bytes(),
+                          make_unique<BlenderAttributeSharedData>(b_attr.sharing_info));
+    return true;
+  }
+}
+
 static void attr_create_generic(Scene *scene,
                                 Mesh *mesh,
                                 const ::Mesh &b_mesh,
@@ -390,6 +433,12 @@ static void attr_create_generic(Scene *scene,
             break;
           }
           case blender::bke::AttrDomain::Point: {
+            /* Subdivision reads the buffer of the attributes directly. */
+            if (!subdivision && b_attr.domain == iter.domain &&
+                attr_share_generic<BlenderT>(attr, b_attr))
+            {
+              break;
+            }
             for (const int i : src.index_range()) {
               data[i] = Converter::convert(src[i]);
             }
@@ -24,6 +24,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 #include "BKE_duplilist.hh"
 
@@ -106,10 +107,11 @@ bool BlenderSync::object_is_camera(BL::Object &b_ob)
   return (b_ob_data && b_ob_data.is_a(&RNA_Camera));
 }
 
-void BlenderSync::sync_object_motion_init(BL::Object &b_parent, BL::Object &b_ob, Object *object)
+void BlenderSync::sync_object_motion_init(ObjectSyncData &data)
 {
   /* Initialize motion blur for object, detecting if it's enabled and creating motion
    * steps array if so. */
+  Object *object = data.object;
   array<Transform> motion;
   object->set_motion(motion);
 
@@ -118,19 +120,8 @@ void BlenderSync::sync_object_motion_init(BL::Object &b_parent, BL::Object &b_ob
     return;
   }
 
-  int motion_steps = 0;
-  bool use_motion_blur = false;
-
-  Scene::MotionType need_motion = scene->need_motion();
-  if (need_motion == Scene::MOTION_BLUR) {
-    motion_steps = object_motion_steps(b_parent, b_ob, Object::MAX_MOTION_STEPS);
-    if (motion_steps && object_use_deform_motion(b_parent, b_ob)) {
-      use_motion_blur = true;
-    }
-  }
-  else if (need_motion != Scene::MOTION_NONE) {
-    motion_steps = 3;
-  }
+  const int motion_steps = data.motion_steps;
+  const bool use_motion_blur = motion_steps && data.use_deform_motion;
 
   geom->set_use_motion_blur(use_motion_blur);
 
@@ -162,7 +153,8 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  bool show_lights,
                                  BlenderObjectCulling &culling,
                                  bool *use_portal,
-                                 TaskPool *geom_task_pool)
+                                 TaskPool *geom_task_pool,
+                                 vector<ObjectSyncData> *object_sync_data)
 {
   const bool is_instance = b_instance.is_instance();
   BL::Object b_ob = b_instance.object();
@@ -216,7 +208,6 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   }
 
   /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
   bool use_holdout = b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
   uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
 
@@ -294,6 +285,54 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
 
   object->set_visibility(visibility);
 
+  /* Reading the Cycles settings creates them when missing, do that here so that the object
+   * settings synced in parallel only read them. */
+  RNA_pointer_get(&b_ob_info.real_object.ptr, "cycles");
+  RNA_pointer_get(&b_parent.ptr, "cycles");
+
+  /* The object used for the instance is a temporary copy which is reused for the next instance,
+   * so copy what differs from the instanced object and sync the rest from that one. */
+  ObjectSyncData data{object,
+                      b_ob_info.real_object,
+                      b_parent,
+                      tfm,
+                      is_instance,
+                      object_updated,
+                      get_float4(b_ob.color()),
+                      zero_float3(),
+                      zero_float2(),
+                      0,
+                      false,
+                      0,
+                      false};
+
+  /* dupli texture coordinates and random_id */
+  if (is_instance) {
+    data.dupli_generated = 0.5f * get_float3(b_instance.orco()) - make_float3(0.5f, 0.5f, 0.5f);
+    data.dupli_uv = get_float2(b_instance.uv());
+    data.random_id = b_instance.random_id();
+  }
+
+  if (is_instance && b_instance.particle_system()) {
+    /* Particle data is read from the instance, sync it right away. */
+    sync_object_settings(data);
+    sync_object_commit(data);
+    sync_dupli_particle(b_parent, b_instance, object);
+  }
+  else {
+    object_sync_data->push_back(data);
+  }
+
+  return object;
+}
+
+void BlenderSync::sync_object_settings(ObjectSyncData &data)
+{
+  Object *object = data.object;
+  BL::Object &b_ob = data.b_ob;
+  BL::Object &b_parent = data.b_parent;
+  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+
   object->set_is_shadow_catcher(b_ob.is_shadow_catcher() || b_parent.is_shadow_catcher());
 
   float shadow_terminator_shading_offset = get_float(cobject, "shadow_terminator_offset");
@@ -333,26 +372,22 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   /* object sync
    * transform comparison should not be needed, but duplis don't work perfect
    * in the depsgraph and may not signal changes, so this is a workaround */
-  if (object->is_modified() || object_updated ||
-      (object->get_geometry() && object->get_geometry()->is_modified()))
-  {
+  data.need_update = object->is_modified() || data.object_updated ||
+                     (object->get_geometry() && object->get_geometry()->is_modified());
+  if (data.need_update) {
     object->name = b_ob.name().c_str();
     object->set_pass_id(b_ob.pass_index());
-    const BL::Array<float, 4> object_color = b_ob.color();
-    object->set_color(get_float3(object_color));
-    object->set_alpha(object_color[3]);
-    object->set_tfm(tfm);
+    object->set_color(float4_to_float3(data.color));
+    object->set_alpha(data.color.w);
+    object->set_tfm(data.tfm);
 
     /* dupli texture coordinates and random_id */
-    if (is_instance) {
-      object->set_dupli_generated(0.5f * get_float3(b_instance.orco()) -
-                                  make_float3(0.5f, 0.5f, 0.5f));
-      object->set_dupli_uv(get_float2(b_instance.uv()));
-      object->set_random_id(b_instance.random_id());
+    object->set_dupli_generated(data.dupli_generated);
+    object->set_dupli_uv(data.dupli_uv);
+    if (data.is_instance) {
+      object->set_random_id(data.random_id);
     }
     else {
-      object->set_dupli_generated(zero_float3());
-      object->set_dupli_uv(zero_float2());
       object->set_random_id(hash_uint2(hash_string(object->name.c_str()), 0));
     }
 
@@ -367,18 +402,26 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     object->set_receiver_light_set(BlenderLightLink::get_receiver_light_set(b_parent, b_ob));
     object->set_shadow_set_membership(BlenderLightLink::get_shadow_set_membership(b_parent, b_ob));
     object->set_blocker_shadow_set(BlenderLightLink::get_blocker_shadow_set(b_parent, b_ob));
-
-    object->tag_update(scene);
   }
 
-  sync_object_motion_init(b_parent, b_ob, object);
+  /* Motion blur steps, applied to the possibly shared geometry when committing. */
+  const Scene::MotionType need_motion = scene->need_motion();
+  if (need_motion == Scene::MOTION_BLUR) {
+    data.motion_steps = object_motion_steps(b_parent, b_ob, Object::MAX_MOTION_STEPS);
+    data.use_deform_motion = data.motion_steps && object_use_deform_motion(b_parent, b_ob);
+  }
+  else if (need_motion != Scene::MOTION_NONE) {
+    data.motion_steps = 3;
+  }
+}
 
-  if (is_instance) {
-    /* Sync possible particle data. */
-    sync_dupli_particle(b_parent, b_instance, object);
+void BlenderSync::sync_object_commit(ObjectSyncData &data)
+{
+  if (data.need_update) {
+    data.object->tag_update(scene);
   }
 
-  return object;
+  sync_object_motion_init(data);
 }
 
 extern "C" DupliObject *rna_hack_DepsgraphObjectInstance_dupli_object_get(PointerRNA *ptr);
@@ -546,6 +589,9 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   /* Task pool for multithreaded geometry sync. */
   TaskPool geom_task_pool;
 
+  /* Objects whose settings are synced after iterating the depsgraph. */
+  vector<ObjectSyncData> object_sync_data;
+
   /* layer data */
   bool motion = motion_time != 0.0f;
 
@@ -626,7 +672,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
                     show_lights,
                     culling,
                     &use_portal,
-                    sync_hair ? NULL : &geom_task_pool);
+                    sync_hair ? NULL : &geom_task_pool,
+                    &object_sync_data);
       }
     }
 
@@ -640,7 +687,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
                   show_lights,
                   culling,
                   &use_portal,
-                  &geom_task_pool);
+                  &geom_task_pool,
+                  &object_sync_data);
     }
 
     cancel = progress.get_cancel();
@@ -648,6 +696,18 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
 
   geom_task_pool.wait_work();
 
+  if (!cancel) {
+    /* Object settings only read from Blender and write to their own object, so they are synced
+     * in parallel. Tagging updates and motion blur touch the scene and shared geometry. */
+    parallel_for(size_t(0), object_sync_data.size(), [&](size_t i) {
+      sync_object_settings(object_sync_data[i]);
+    });
+
+    for (ObjectSyncData &data : object_sync_data) {
+      sync_object_commit(data);
+    }
+  }
+
   progress.set_sync_status("");
 
   if (!cancel && !motion) {
@@ -854,6 +854,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
+  params.use_bvh_refit = RNA_boolean_get(&cscene, "debug_use_bvh_refit");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
@@ -875,9 +876,16 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
     params.texture_limit = 0;
   }
 
+  params.use_texture_cache = get_boolean(cscene, "use_texture_cache");
+  params.texture_cache_size = get_int(cscene, "texture_cache_size");
+
+  params.use_attribute_quantization = get_boolean(cscene, "use_attribute_quantization");
+  params.attribute_quantization_tolerance = get_float(cscene, "attribute_quantization_tolerance");
+
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
   params.background = background;
+  params.use_persistent_data = b_scene.render().use_persistent_data();
 
   return params;
 }
@@ -977,9 +985,12 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_tile_streaming = params.use_auto_tile &&
+                                RNA_boolean_get(&cscene, "use_tile_streaming");
   }
   else {
     params.use_auto_tile = false;
+    params.use_tile_streaming = false;
   }
 
   return params;
@@ -133,6 +133,27 @@ class BlenderSync {
                                      ShaderGraph *graph,
                                      BL::Depsgraph &b_depsgraph);
 
+  /* Object settings which are gathered in parallel after the depsgraph has been iterated and
+   * committed to the object afterwards. Only references data that outlives the iteration, the
+   * remaining data of the instance is copied. */
+  struct ObjectSyncData {
+    Object *object;
+    BL::Object b_ob;
+    BL::Object b_parent;
+    Transform tfm;
+    bool is_instance;
+    bool object_updated;
+    float4 color;
+    float3 dupli_generated;
+    float2 dupli_uv;
+    uint random_id;
+
+    /* Filled in by #sync_object_settings. */
+    bool need_update;
+    int motion_steps;
+    bool use_deform_motion;
+  };
+
   /* Object */
   Object *sync_object(BL::Depsgraph &b_depsgraph,
                       BL::ViewLayer &b_view_layer,
@@ -142,8 +163,11 @@ class BlenderSync {
                       bool show_lights,
                       BlenderObjectCulling &culling,
                       bool *use_portal,
-                      TaskPool *geom_task_pool);
-  void sync_object_motion_init(BL::Object &b_parent, BL::Object &b_ob, Object *object);
+                      TaskPool *geom_task_pool,
+                      vector<ObjectSyncData> *object_sync_data);
+  void sync_object_settings(ObjectSyncData &data);
+  void sync_object_commit(ObjectSyncData &data);
+  void sync_object_motion_init(ObjectSyncData &data);
 
   void sync_procedural(BL::Object &b_ob,
                        BL::MeshSequenceCacheModifier &b_mesh_cache,
@@ -146,7 +146,9 @@ void BVHEmbree::build(Progress &progress,
   build_quality = dynamic ? RTC_BUILD_QUALITY_LOW :
                             (params.use_spatial_split ? RTC_BUILD_QUALITY_HIGH :
                                                         RTC_BUILD_QUALITY_MEDIUM);
-  rtcSetSceneBuildQuality(scene, build_quality);
+  /* Embree only builds a separate BVH per geometry, which can then be refit individually, when
+   * the scene quality is low. The geometry BVHs are still built with the requested quality. */
+  rtcSetSceneBuildQuality(scene, params.use_refit ? RTC_BUILD_QUALITY_LOW : build_quality);
 
   int i = 0;
   foreach (Object *ob, objects) {
@@ -227,6 +229,12 @@ void BVHEmbree::add_object(Object *ob, int i)
 {
   Geometry *geom = ob->get_geometry();
 
+  if (params.top_level) {
+    /* Geometry in the scene BVH has no BVH of its own that would keep track of this. */
+    geom->bvh_num_refits = 0;
+    geom->bvh_build_area = geom->bounds.safe_area();
+  }
+
   if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
     Mesh *mesh = static_cast<Mesh *>(geom);
     if (mesh->num_triangles() > 0) {
@@ -339,7 +347,7 @@ void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
       std::memcpy(triangles_buffer, triangles, sizeof(int) * 3 * (num_triangles));
     }
   }
-  set_tri_vertex_buffer(geom_id, mesh, false);
+  set_tri_vertex_buffer(geom_id, mesh);
 
   rtcSetGeometryUserData(geom_id, (void *)prim_offset);
   rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
@@ -355,7 +363,7 @@ void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
   rtcReleaseGeometry(geom_id);
 }
 
-void BVHEmbree::set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update)
+void BVHEmbree::set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh)
 {
   const Attribute *attr_mP = NULL;
   size_t num_motion_steps = 1;
@@ -383,47 +391,42 @@ void BVHEmbree::set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, con
       verts = &attr_mP->data_float3()[t_ * num_verts];
     }
 
-    if (update) {
-      rtcUpdateGeometryBuffer(geom_id, RTC_BUFFER_TYPE_VERTEX, t);
+    if (!rtc_device_is_sycl) {
+      /* NOTE(sirgienko) Embree requires padding for VERTEX layout as last buffer element
+       * must be readable using 16-byte SSE load instructions. Because of this, we are
+       * artificially increasing shared buffer size by 1 - it shouldn't cause any memory
+       * access violation as this last element is not accessed directly since no triangle
+       * can reference it. */
+      rtcSetSharedGeometryBuffer(geom_id,
+                                 RTC_BUFFER_TYPE_VERTEX,
+                                 t,
+                                 RTC_FORMAT_FLOAT3,
+                                 verts,
+                                 0,
+                                 sizeof(float3),
+                                 num_verts + 1);
     }
     else {
-      if (!rtc_device_is_sycl) {
-        /* NOTE(sirgienko) Embree requires padding for VERTEX layout as last buffer element
-         * must be readable using 16-byte SSE load instructions. Because of this, we are
-         * artificially increasing shared buffer size by 1 - it shouldn't cause any memory
-         * access violation as this last element is not accessed directly since no triangle
-         * can reference it. */
-        rtcSetSharedGeometryBuffer(geom_id,
-                                   RTC_BUFFER_TYPE_VERTEX,
-                                   t,
-                                   RTC_FORMAT_FLOAT3,
-                                   verts,
-                                   0,
-                                   sizeof(float3),
-                                   num_verts + 1);
-      }
-      else {
-        /* NOTE(sirgienko): If the Embree device is a SYCL device, then Embree execution will
-         * happen on GPU, and we cannot use standard host pointers at this point. So instead
-         * of making a shared geometry buffer - a new Embree buffer will be created and data
-         * will be copied. */
-        /* As float3 is packed on GPU side, we map it to packed_float3. */
-        /* There is no need for additional padding in rtcSetNewGeometryBuffer since Embree 3.6:
-         * "Fixed automatic vertex buffer padding when using rtcSetNewGeometry API function". */
-        packed_float3 *verts_buffer = (packed_float3 *)rtcSetNewGeometryBuffer(
-            geom_id,
-            RTC_BUFFER_TYPE_VERTEX,
-            t,
-            RTC_FORMAT_FLOAT3,
-            sizeof(packed_float3),
-            num_verts);
-        assert(verts_buffer);
-        if (verts_buffer) {
-          for (size_t i = (size_t)0; i < num_verts; ++i) {
-            verts_buffer[i].x = verts[i].x;
-            verts_buffer[i].y = verts[i].y;
-            verts_buffer[i].z = verts[i].z;
-          }
+      /* NOTE(sirgienko): If the Embree device is a SYCL device, then Embree execution will
+       * happen on GPU, and we cannot use standard host pointers at this point. So instead
+       * of making a shared geometry buffer - a new Embree buffer will be created and data
+       * will be copied. */
+      /* As float3 is packed on GPU side, we map it to packed_float3. */
+      /* There is no need for additional padding in rtcSetNewGeometryBuffer since Embree 3.6:
+       * "Fixed automatic vertex buffer padding when using rtcSetNewGeometry API function". */
+      packed_float3 *verts_buffer = (packed_float3 *)rtcSetNewGeometryBuffer(
+          geom_id,
+          RTC_BUFFER_TYPE_VERTEX,
+          t,
+          RTC_FORMAT_FLOAT3,
+          sizeof(packed_float3),
+          num_verts);
+      assert(verts_buffer);
+      if (verts_buffer) {
+        for (size_t i = (size_t)0; i < num_verts; ++i) {
+          verts_buffer[i].x = verts[i].x;
+          verts_buffer[i].y = verts[i].y;
+          verts_buffer[i].z = verts[i].z;
         }
       }
     }
@@ -680,6 +683,26 @@ void BVHEmbree::add_curves(const Object *ob, const Hair *hair, int i)
   rtcReleaseGeometry(geom_id);
 }
 
+RTCBuildQuality BVHEmbree::refit_build_quality(Geometry *geom)
+{
+  if (!params.use_refit) {
+    return build_quality;
+  }
+
+  /* For geometry level BVHs #Geometry::compute_bvh already decided to refit, geometry in the
+   * scene BVH is rebuilt here when refitting degraded it too much. */
+  if (params.top_level) {
+    if (geom->bvh_refit_degraded()) {
+      geom->bvh_num_refits = 0;
+      geom->bvh_build_area = geom->bounds.safe_area();
+      return build_quality;
+    }
+    geom->bvh_num_refits++;
+  }
+
+  return RTC_BUILD_QUALITY_REFIT;
+}
+
 void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
@@ -687,34 +710,55 @@ void BVHEmbree::refit(Progress &progress)
   /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
-      Geometry *geom = ob->get_geometry();
-
-      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
-        Mesh *mesh = static_cast<Mesh *>(geom);
-        if (mesh->num_triangles() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id);
-          set_tri_vertex_buffer(geom, mesh, true);
-          rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
-          rtcCommitGeometry(geom);
-        }
+    Geometry *geom = ob->get_geometry();
+
+    if (params.top_level && ob->is_traceable() && geom->is_modified()) {
+      if (geom->is_instanced()) {
+        /* The instanced BVH was refit or rebuilt into a new scene before, update the instance
+         * so its bounds are recomputed. */
+        const BVHEmbree *instance_bvh = static_cast<const BVHEmbree *>(geom->bvh);
+        RTCGeometry rtc_geom = rtcGetGeometry(scene, geom_id);
+        rtcSetGeometryInstancedScene(rtc_geom, instance_bvh->scene);
+        rtcSetGeometryUserData(rtc_geom, (void *)instance_bvh->scene);
+        rtcCommitGeometry(rtc_geom);
+        geom_id += 2;
+        continue;
       }
-      else if (geom->geometry_type == Geometry::HAIR) {
-        Hair *hair = static_cast<Hair *>(geom);
-        if (hair->num_curves() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
-          set_curve_vertex_buffer(geom, hair, true);
-          rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
-          rtcCommitGeometry(geom);
-        }
+    }
+    else if (params.top_level) {
+      /* Unmodified geometry keeps its BVH, transforms did not change when refitting. */
+      geom_id += 2;
+      continue;
+    }
+
+    if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
+      Mesh *mesh = static_cast<Mesh *>(geom);
+      if (mesh->num_triangles() > 0) {
+        RTCGeometry rtc_geom = rtcGetGeometry(scene, geom_id);
+        /* Embree only supports refitting triangles, curves and points are rebuilt. */
+        rtcSetGeometryBuildQuality(rtc_geom, refit_build_quality(mesh));
+        /* Set the vertex buffers again instead of only tagging them as updated, the shared
+         * arrays may have been reallocated and the buffers of SYCL devices are copies. */
+        set_tri_vertex_buffer(rtc_geom, mesh);
+        rtcSetGeometryUserData(rtc_geom, (void *)mesh->prim_offset);
+        rtcCommitGeometry(rtc_geom);
       }
-      else if (geom->geometry_type == Geometry::POINTCLOUD) {
-        PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-        if (pointcloud->num_points() > 0) {
-          RTCGeometry geom = rtcGetGeometry(scene, geom_id);
-          set_point_vertex_buffer(geom, pointcloud, true);
-          rtcCommitGeometry(geom);
-        }
+    }
+    else if (geom->geometry_type == Geometry::HAIR) {
+      Hair *hair = static_cast<Hair *>(geom);
+      if (hair->num_curves() > 0) {
+        RTCGeometry rtc_geom = rtcGetGeometry(scene, geom_id + 1);
+        set_curve_vertex_buffer(rtc_geom, hair, true);
+        rtcSetGeometryUserData(rtc_geom, (void *)hair->curve_segment_offset);
+        rtcCommitGeometry(rtc_geom);
+      }
+    }
+    else if (geom->geometry_type == Geometry::POINTCLOUD) {
+      PointCloud *pointcloud = static_cast<PointCloud *>(geom);
+      if (pointcloud->num_points() > 0) {
+        RTCGeometry rtc_geom = rtcGetGeometry(scene, geom_id);
+        set_point_vertex_buffer(rtc_geom, pointcloud, true);
+        rtcCommitGeometry(rtc_geom);
       }
     }
     geom_id += 2;
@@ -59,7 +59,8 @@ class BVHEmbree : public BVH {
   void add_triangles(const Object *ob, const Mesh *mesh, int i);
 
  private:
-  void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh, const bool update);
+  RTCBuildQuality refit_build_quality(Geometry *geom);
+  void set_tri_vertex_buffer(RTCGeometry geom_id, const Mesh *mesh);
   void set_curve_vertex_buffer(RTCGeometry geom_id, const Hair *hair, const bool update);
   void set_point_vertex_buffer(RTCGeometry geom_id,
                                const PointCloud *pointcloud,
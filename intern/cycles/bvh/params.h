@@ -91,6 +91,9 @@ class BVHParams {
   /* Use compact acceleration structure (Embree)*/
   bool use_compact_structure;
 
+  /* Build the BVH so that deforming geometry can be refit later instead of rebuilt (Embree). */
+  bool use_refit;
+
   /* Split time range to this number of steps and create leaf node for each
    * of this time steps.
    *
@@ -134,6 +137,7 @@ class BVHParams {
     top_level = false;
     bvh_layout = BVH_LAYOUT_BVH2;
     use_compact_structure = false;
+    use_refit = false;
     use_unaligned_nodes = false;
 
     num_motion_curve_steps = 0;
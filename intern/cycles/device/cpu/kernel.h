@@ -27,6 +27,8 @@ class CPUKernels {
                                                             IntegratorStateCPU *state,
                                                             KernelWorkTile *tile,
                                                             ccl_global float *render_buffer)>;
+  using IntegratorStepFunction = CPUKernelFunction<bool (*)(
+      const KernelGlobalsCPU *kg, IntegratorStateCPU *state, ccl_global float *render_buffer)>;
 
   IntegratorInitFunction integrator_init_from_camera;
   IntegratorInitFunction integrator_init_from_bake;
@@ -42,6 +44,8 @@ class CPUKernels {
   IntegratorShadeFunction integrator_shade_volume;
   IntegratorShadeFunction integrator_shade_dedicated_light;
   IntegratorShadeFunction integrator_megakernel;
+  IntegratorStepFunction integrator_megakernel_shadow_step;
+  IntegratorStepFunction integrator_megakernel_path_step;
 
   /* Shader evaluation. */
 
@@ -995,24 +995,36 @@ bool PathTrace::copy_render_tile_from_device()
   return success;
 }
 
-static string get_layer_view_name(const RenderBuffers &buffers)
+static string get_layer_view_name(const BufferParams &params)
 {
   string result;
 
-  if (buffers.params.layer.size()) {
-    result += string(buffers.params.layer);
+  if (params.layer.size()) {
+    result += string(params.layer);
   }
 
-  if (buffers.params.view.size()) {
+  if (params.view.size()) {
     if (!result.empty()) {
       result += ", ";
     }
-    result += string(buffers.params.view);
+    result += string(params.view);
   }
 
   return result;
 }
 
+void PathTrace::report_full_buffer_read_error()
+{
+  const string error_message = "Error reading tiles from file";
+  if (progress_) {
+    progress_->set_error(error_message);
+    progress_->set_cancel(error_message);
+  }
+  else {
+    LOG(ERROR) << error_message;
+  }
+}
+
 void PathTrace::process_full_buffer_from_disk(string_view filename)
 {
   VLOG_WORK << "Processing full frame buffer file " << filename;
@@ -1023,18 +1035,11 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   DenoiseParams denoise_params;
   if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
-    }
+    report_full_buffer_read_error();
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  const string layer_view_name = get_layer_view_name(full_frame_buffers.params);
 
   render_state_.has_denoised_result = false;
 
@@ -1069,6 +1074,63 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+void PathTrace::process_full_buffer_tiles_from_disk(string_view filename)
+{
+  VLOG_WORK << "Processing full frame buffer file " << filename << " in tiles";
+
+  progress_set_status("Reading full buffer from disk");
+
+  BufferParams full_frame_params;
+  DenoiseParams denoise_params;
+  if (!tile_manager_.open_full_buffer_from_disk(filename, &full_frame_params, &denoise_params)) {
+    report_full_buffer_read_error();
+    return;
+  }
+
+  const string layer_view_name = get_layer_view_name(full_frame_params);
+
+  render_state_.has_denoised_result = false;
+
+  if (denoise_params.use) {
+    /* See process_full_buffer_from_disk() for why this is safe. */
+    denoise_params.use_gpu = render_scheduler_.is_denoiser_gpu_used();
+    set_denoiser_params(denoise_params);
+  }
+
+  /* Tiles are denoised including their overlap with neighbor tiles, and only their window is
+   * written to the software. */
+  RenderBuffers tile_buffers(cpu_device_.get());
+
+  const int num_tiles = tile_manager_.get_num_full_buffer_tiles();
+  for (int tile_index = 0; tile_index < num_tiles; ++tile_index) {
+    progress_set_status(layer_view_name,
+                        string_printf("Finishing tile %d/%d", tile_index + 1, num_tiles));
+
+    if (!tile_manager_.read_full_buffer_tile_from_disk(tile_index, &tile_buffers)) {
+      report_full_buffer_read_error();
+      break;
+    }
+
+    if (denoise_params.use) {
+      denoiser_->denoise_buffer(tile_buffers.params, &tile_buffers, 0, false);
+      render_state_.has_denoised_result = true;
+    }
+
+    const BufferParams &tile_params = tile_buffers.params;
+    full_frame_state_.render_buffers = &tile_buffers;
+    full_frame_state_.offset = make_int2(
+        tile_params.full_x - full_frame_params.full_x + tile_params.window_x,
+        tile_params.full_y - full_frame_params.full_y + tile_params.window_y);
+
+    tile_buffer_write();
+
+    full_frame_state_.render_buffers = nullptr;
+    full_frame_state_.offset = make_int2(0, 0);
+  }
+
+  tile_manager_.close_full_buffer_from_disk();
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -1139,7 +1201,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
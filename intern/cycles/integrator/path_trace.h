@@ -139,6 +139,10 @@ class PathTrace {
    * via the write callback. */
   void process_full_buffer_from_disk(string_view filename);
 
+  /* Same as above, but read, denoise and write the full-frame file in tiles of bounded size
+   * instead of loading it into memory at once. */
+  void process_full_buffer_tiles_from_disk(string_view filename);
+
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
@@ -240,6 +244,9 @@ class PathTrace {
   /* Write current tile into the file on disk. */
   void tile_buffer_write_to_disk();
 
+  /* Report failure to read the full-frame file from disk as a session error. */
+  void report_full_buffer_read_error();
+
   /* Run the progress_update_cb callback if it is needed. */
   void progress_update_if_needed(const RenderWork &render_work);
 
@@ -354,6 +361,8 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+    /* Offset of the render buffers window in the frame, when processing it in tiles. */
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
@@ -16,7 +16,10 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/algorithm.h"
+#include "util/array.h"
 #include "util/atomic.h"
+#include "util/debug.h"
 #include "util/log.h"
 #include "util/tbb.h"
 
@@ -31,6 +34,22 @@ static inline tbb::task_arena local_tbb_arena_create(const Device *device)
   return tbb::task_arena(device->info.cpu_threads);
 }
 
+/* Memory for the path states of one thread in the wavefront mode. The number of pixels whose
+ * paths are in flight together is derived from it, so that the states of many paths can be
+ * grouped by shader without using much more memory than the full pipeline. */
+static constexpr size_t WAVEFRONT_STATES_MEMORY = 8 * 1024 * 1024;
+static constexpr int WAVEFRONT_BATCH_SIZE_MIN = 16;
+static constexpr int WAVEFRONT_BATCH_SIZE_MAX = 1024;
+
+static int wavefront_batch_size(const int states_per_pixel)
+{
+  const size_t batch_size = WAVEFRONT_STATES_MEMORY /
+                            (sizeof(IntegratorStateCPU) * states_per_pixel);
+  return clamp(int(min(batch_size, size_t(WAVEFRONT_BATCH_SIZE_MAX))),
+               WAVEFRONT_BATCH_SIZE_MIN,
+               WAVEFRONT_BATCH_SIZE_MAX);
+}
+
 /* Get CPUKernelThreadGlobals for the current thread. */
 static inline CPUKernelThreadGlobals *kernel_thread_globals_get(
     vector<CPUKernelThreadGlobals> &kernel_thread_globals)
@@ -56,6 +75,10 @@ void PathTraceWorkCPU::init_execution()
 {
   /* Cache per-thread kernel globals. */
   device_->get_cpu_kernel_thread_globals(kernel_thread_globals_);
+
+  /* The states themselves are only allocated by the threads when the wavefront mode is used. */
+  wavefront_thread_states_.clear();
+  wavefront_thread_states_.resize(kernel_thread_globals_.size());
 }
 
 void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
@@ -73,8 +96,44 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* Path guiding records the segments of one path at a time per thread. */
+  const bool use_wavefront = DebugFlags().cpu.wavefront &&
+                             !device_scene_->data.integrator.use_guiding;
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
+    if (use_wavefront) {
+      const int states_per_pixel = device_scene_->data.integrator.has_shadow_catcher ? 2 : 1;
+      const int batch_size = wavefront_batch_size(states_per_pixel);
+      const int64_t batches_num = divide_up(total_pixels_num, int64_t(batch_size));
+      parallel_for(int64_t(0), batches_num, [&](int64_t batch_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
+
+        const int64_t pixel_index = batch_index * batch_size;
+        const int pixels_num = min(total_pixels_num - pixel_index, int64_t(batch_size));
+
+        KernelWorkTile work_tile;
+        work_tile.w = 1;
+        work_tile.h = 1;
+        work_tile.start_sample = start_sample;
+        work_tile.sample_offset = sample_offset;
+        work_tile.num_samples = 1;
+        work_tile.offset = effective_buffer_params_.offset;
+        work_tile.stride = effective_buffer_params_.stride;
+
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(
+            kernel_thread_globals_);
+        WavefrontThreadStates &thread_states =
+            wavefront_thread_states_[tbb::this_task_arena::current_thread_index()];
+
+        render_samples_wavefront(
+            kernel_globals, thread_states, work_tile, pixel_index, pixels_num, samples_num);
+      });
+      return;
+    }
+
     parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
       if (is_cancel_requested()) {
         return;
@@ -164,6 +223,102 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_glo
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                                WavefrontThreadStates &thread_states,
+                                                const KernelWorkTile &work_tile,
+                                                const int64_t pixel_index,
+                                                const int pixels_num,
+                                                const int samples_num)
+{
+  const bool has_bake = device_scene_->data.bake.use;
+  const int64_t image_width = effective_buffer_params_.width;
+  float *render_buffer = buffers_->buffer.data();
+
+  const int states_per_pixel = device_scene_->data.integrator.has_shadow_catcher ? 2 : 1;
+  const int states_num = pixels_num * states_per_pixel;
+  if (thread_states.states.size() < size_t(states_num)) {
+    thread_states.states.resize(states_num);
+  }
+  IntegratorStateCPU *states = thread_states.states.data();
+  /* Paths of a cancelled batch may still be queued. */
+  for (int i = 0; i < states_num; i++) {
+    path_state_init_queues(&states[i]);
+  }
+
+  array<bool> &pixel_done = thread_states.pixel_done;
+  if (pixel_done.size() < size_t(pixels_num)) {
+    pixel_done.resize(pixels_num);
+  }
+  std::fill(pixel_done.begin(), pixel_done.begin() + pixels_num, false);
+
+  vector<uint64_t> &queued = thread_states.queued;
+  queued.reserve(states_num);
+
+  KernelWorkTile sample_work_tile = work_tile;
+
+  for (int sample = 0; sample < samples_num; ++sample) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    for (int i = 0; i < pixels_num; i++) {
+      if (pixel_done[i]) {
+        continue;
+      }
+
+      const int64_t work_index = pixel_index + i;
+      const int y = work_index / image_width;
+      const int x = work_index - y * image_width;
+      sample_work_tile.x = effective_buffer_params_.full_x + x;
+      sample_work_tile.y = effective_buffer_params_.full_y + y;
+
+      IntegratorStateCPU *state = &states[i * states_per_pixel];
+      if (has_bake) {
+        pixel_done[i] = !kernels_.integrator_init_from_bake(
+            kernel_globals, state, &sample_work_tile, render_buffer);
+      }
+      else {
+        pixel_done[i] = !kernels_.integrator_init_from_camera(
+            kernel_globals, state, &sample_work_tile, render_buffer);
+      }
+    }
+
+    while (true) {
+      /* Shadow and AO paths first, a path only has room for one of each. Stepping all of them
+       * together keeps the shadow intersection and shading kernels batched as well. */
+      bool has_shadow_paths = true;
+      while (has_shadow_paths) {
+        has_shadow_paths = false;
+        for (int i = 0; i < states_num; i++) {
+          has_shadow_paths |= kernels_.integrator_megakernel_shadow_step(
+              kernel_globals, &states[i], render_buffer);
+        }
+      }
+
+      /* Then one kernel for every main path, grouped by kernel and by shader within each. */
+      queued.clear();
+      for (int i = 0; i < states_num; i++) {
+        const uint64_t queued_kernel = states[i].path.queued_kernel;
+        if (queued_kernel) {
+          const uint64_t shader = min(states[i].path.shader_sort_key, uint32_t(0xFFFF));
+          queued.push_back((queued_kernel << 48) | (shader << 32) | uint64_t(i));
+        }
+      }
+      if (queued.empty()) {
+        break;
+      }
+
+      std::sort(queued.begin(), queued.end());
+      for (const uint64_t key : queued) {
+        const int i = int(key & 0xFFFFFFFF);
+        kernels_.integrator_megakernel_path_step(kernel_globals, &states[i], render_buffer);
+      }
+    }
+
+    ++sample_work_tile.start_sample;
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        int num_samples)
@@ -11,6 +11,7 @@
 
 #include "integrator/path_trace_work.h"
 
+#include "util/array.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -74,6 +75,28 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Storage of the wavefront mode, allocated once per thread and reused for all batches of
+   * pixels rendered by that thread. */
+  struct WavefrontThreadStates {
+    /* Path states of the pixels in flight. With a shadow catcher every pixel has two consecutive
+     * states, the second one receives the split off shadow catcher path. */
+    array<IntegratorStateCPU> states;
+    /* Pixels which need no more samples, like the full pipeline stops sampling them. */
+    array<bool> pixel_done;
+    /* Paths queued for a main path kernel, as (kernel, shader, state) sort keys. */
+    vector<uint64_t> queued;
+  };
+
+  /* Wavefront alternative to the full pipeline, see #DebugFlags::CPU::wavefront. Renders the
+   * pixels from `pixel_index` to `pixel_index + pixels_num`, advancing all of their paths one
+   * kernel at a time with paths grouped by kernel and shader for more coherent execution. */
+  void render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                WavefrontThreadStates &thread_states,
+                                const KernelWorkTile &work_tile,
+                                const int64_t pixel_index,
+                                const int pixels_num,
+                                const int samples_num);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +106,9 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Indexed like `kernel_thread_globals_`. */
+  vector<WavefrontThreadStates> wavefront_thread_states_;
 };
 
 CCL_NAMESPACE_END
@@ -702,6 +702,17 @@ string RenderScheduler::full_report() const
   return result;
 }
 
+RenderScheduler::WorkTimes RenderScheduler::get_work_times() const
+{
+  WorkTimes times;
+  times.path_trace = path_trace_time_.get_wall();
+  times.adaptive_filter = adaptive_filter_time_.get_wall();
+  times.denoise = denoise_time_.get_wall();
+  times.display_update = display_update_time_.get_wall();
+  times.rebalance = rebalance_time_.get_wall();
+  return times;
+}
+
 double RenderScheduler::guess_display_update_interval_in_seconds() const
 {
   return guess_display_update_interval_in_seconds_for_num_samples(state_.num_rendered_samples);
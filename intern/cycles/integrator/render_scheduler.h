@@ -189,6 +189,16 @@ class RenderScheduler {
    * times, and so on. */
   string full_report() const;
 
+  /* Wall time (in seconds) spent on the different kinds of work since the last reset. */
+  struct WorkTimes {
+    double path_trace = 0.0;
+    double adaptive_filter = 0.0;
+    double denoise = 0.0;
+    double display_update = 0.0;
+    double rebalance = 0.0;
+  };
+  WorkTimes get_work_times() const;
+
   void set_limit_samples_per_update(const int limit_samples);
 
  protected:
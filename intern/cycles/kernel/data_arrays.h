@@ -54,6 +54,7 @@ KERNEL_DATA_ARRAY(float2, attributes_float2)
 KERNEL_DATA_ARRAY(packed_float3, attributes_float3)
 KERNEL_DATA_ARRAY(float4, attributes_float4)
 KERNEL_DATA_ARRAY(uchar4, attributes_uchar4)
+KERNEL_DATA_ARRAY(uint, attributes_quantized)
 
 /* lights */
 KERNEL_DATA_ARRAY(KernelLightDistribution, light_distribution)
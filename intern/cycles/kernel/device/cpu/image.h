@@ -10,6 +10,16 @@
 
 CCL_NAMESPACE_BEGIN
 
+#ifdef __TEXTURE_CACHE__
+/* Filtered lookup in an image read through the texture cache, with the footprint given as UV
+ * derivatives. Defined once in kernel.cpp as it calls into OpenImageIO. */
+float4 kernel_tex_image_cache_lookup(const TextureInfo &info,
+                                     float x,
+                                     float y,
+                                     float2 duv_dx,
+                                     float2 duv_dy);
+#endif
+
 /* Make template functions private so symbols don't conflict between kernels with different
  * instruction sets. */
 namespace {
@@ -844,6 +854,10 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
       return TextureInterpolator<ushort4>::interp(info, x, y);
     case IMAGE_DATA_TYPE_FLOAT4:
       return TextureInterpolator<float4>::interp(info, x, y);
+#ifdef __TEXTURE_CACHE__
+    case IMAGE_DATA_TYPE_TEXTURE_CACHE:
+      return kernel_tex_image_cache_lookup(info, x, y, zero_float2(), zero_float2());
+#endif
     default:
       assert(0);
       return make_float4(
@@ -851,6 +865,21 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
   }
 }
 
+#ifdef __TEXTURE_CACHE__
+/* Lookup with a footprint for mipmap selection, which only the texture cache makes use of. */
+ccl_device float4 kernel_tex_image_interp(
+    KernelGlobals kg, int id, float x, float y, float2 duv_dx, float2 duv_dy)
+{
+  const TextureInfo &info = kernel_data_fetch(texture_info, id);
+
+  if (info.data_type == IMAGE_DATA_TYPE_TEXTURE_CACHE) {
+    return kernel_tex_image_cache_lookup(info, x, y, duv_dx, duv_dy);
+  }
+
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+#endif
+
 ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals kg,
                                              int id,
                                              float3 P,
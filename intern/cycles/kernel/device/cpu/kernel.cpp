@@ -47,6 +47,10 @@
 #define KERNEL_ARCH cpu
 #include "kernel/device/cpu/kernel_arch_impl.h"
 
+#ifdef __TEXTURE_CACHE__
+#  include <OpenImageIO/texture.h>
+#endif
+
 CCL_NAMESPACE_BEGIN
 
 /* Memory Copy */
@@ -77,4 +81,72 @@ void kernel_global_memory_copy(KernelGlobalsCPU *kg, const char *name, void *mem
   }
 }
 
+/* Texture Cache */
+
+#ifdef __TEXTURE_CACHE__
+float4 kernel_tex_image_cache_lookup(const TextureInfo &info,
+                                     const float x,
+                                     const float y,
+                                     const float2 duv_dx,
+                                     const float2 duv_dy)
+{
+  const TextureCacheImage *image = (const TextureCacheImage *)info.data;
+  OIIO::TextureSystem *ts = (OIIO::TextureSystem *)image->texture_system;
+
+  OIIO::TextureOpt options;
+  switch (info.interpolation) {
+    case INTERPOLATION_CLOSEST:
+      options.interpmode = OIIO::TextureOpt::InterpClosest;
+      break;
+    case INTERPOLATION_CUBIC:
+      options.interpmode = OIIO::TextureOpt::InterpBicubic;
+      break;
+    case INTERPOLATION_SMART:
+      options.interpmode = OIIO::TextureOpt::InterpSmartBicubic;
+      break;
+    default:
+      options.interpmode = OIIO::TextureOpt::InterpBilinear;
+      break;
+  }
+  switch (info.extension) {
+    case EXTENSION_REPEAT:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapPeriodic;
+      break;
+    case EXTENSION_EXTEND:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapClamp;
+      break;
+    case EXTENSION_MIRROR:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapMirror;
+      break;
+    default:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapBlack;
+      break;
+  }
+  /* Opaque alpha for images without an alpha channel. */
+  options.fill = 1.0f;
+
+  /* Images are stored bottom to top, while the texture system goes top to bottom. */
+  float result[4];
+  if (!ts->texture((OIIO::TextureSystem::TextureHandle *)image->texture_handle,
+                   nullptr,
+                   options,
+                   x,
+                   1.0f - y,
+                   duv_dx.x,
+                   -duv_dx.y,
+                   duv_dy.x,
+                   -duv_dy.y,
+                   4,
+                   result))
+  {
+    /* Clear the error so messages don't accumulate for every failed lookup. */
+    ts->geterror();
+    return make_float4(
+        TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
+  }
+
+  return make_float4(result[0], result[1], result[2], result[3]);
+}
+#endif
+
 CCL_NAMESPACE_END
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "util/quantize.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Attributes
@@ -99,6 +101,77 @@ ccl_device_inline AttributeDescriptor find_attribute(KernelGlobals kg,
   return find_attribute(kg, sd->object, sd->prim, sd->type, id);
 }
 
+/* Attribute data, which may be stored with reduced precision in the attributes_quantized array.
+ * The index is then in elements of the encoding, which take 1, 2, 4 or 8 bytes. */
+
+ccl_device float attribute_data_float(KernelGlobals kg,
+                                      const AttributeDescriptor desc,
+                                      const int index)
+{
+  if (!(desc.flags & ATTR_QUANTIZED)) {
+    return kernel_data_fetch(attributes_float, index);
+  }
+
+  const bool is_signed = (desc.flags & ATTR_QUANTIZED_SIGNED) != 0;
+
+  if (desc.flags & ATTR_QUANTIZED_NORM8) {
+    const uint word = kernel_data_fetch(attributes_quantized, index >> 2);
+    return norm_to_float((word >> ((index & 3) * 8)) & 0xff, true, is_signed);
+  }
+
+  const uint word = kernel_data_fetch(attributes_quantized, index >> 1);
+  const uint bits = (word >> ((index & 1) * 16)) & 0xffff;
+  return (desc.flags & ATTR_QUANTIZED_NORM16) ? norm_to_float(bits, false, is_signed) :
+                                                half_bits_to_float(bits);
+}
+
+ccl_device float2 attribute_data_float2(KernelGlobals kg,
+                                        const AttributeDescriptor desc,
+                                        const int index)
+{
+  if (!(desc.flags & ATTR_QUANTIZED)) {
+    return kernel_data_fetch(attributes_float2, index);
+  }
+
+  const uint word = kernel_data_fetch(attributes_quantized, index);
+  return make_float2(half_bits_to_float(word & 0xffff), half_bits_to_float(word >> 16));
+}
+
+ccl_device float3 attribute_data_float3(KernelGlobals kg,
+                                        const AttributeDescriptor desc,
+                                        const int index)
+{
+  if (!(desc.flags & ATTR_QUANTIZED)) {
+    return kernel_data_fetch(attributes_float3, index);
+  }
+
+  if (desc.flags & ATTR_QUANTIZED_OCTAHEDRAL) {
+    return octahedral_to_float3(kernel_data_fetch(attributes_quantized, index));
+  }
+
+  const uint word0 = kernel_data_fetch(attributes_quantized, index * 2 + 0);
+  const uint word1 = kernel_data_fetch(attributes_quantized, index * 2 + 1);
+  return make_float3(half_bits_to_float(word0 & 0xffff),
+                     half_bits_to_float(word0 >> 16),
+                     half_bits_to_float(word1 & 0xffff));
+}
+
+ccl_device float4 attribute_data_float4(KernelGlobals kg,
+                                        const AttributeDescriptor desc,
+                                        const int index)
+{
+  if (!(desc.flags & ATTR_QUANTIZED)) {
+    return kernel_data_fetch(attributes_float4, index);
+  }
+
+  const uint word0 = kernel_data_fetch(attributes_quantized, index * 2 + 0);
+  const uint word1 = kernel_data_fetch(attributes_quantized, index * 2 + 1);
+  return make_float4(half_bits_to_float(word0 & 0xffff),
+                     half_bits_to_float(word0 >> 16),
+                     half_bits_to_float(word1 & 0xffff),
+                     half_bits_to_float(word1 >> 16));
+}
+
 /* Transform matrix attribute on meshes */
 
 ccl_device Transform primitive_attribute_matrix(KernelGlobals kg, const AttributeDescriptor desc)
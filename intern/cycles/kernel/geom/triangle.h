@@ -162,15 +162,15 @@ ccl_device float triangle_attribute_float(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint3 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
 
-      f0 = kernel_data_fetch(attributes_float, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float, desc.offset + tri_vindex.z);
+      f0 = attribute_data_float(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_float(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_float(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
-      f0 = kernel_data_fetch(attributes_float, tri + 0);
-      f1 = kernel_data_fetch(attributes_float, tri + 1);
-      f2 = kernel_data_fetch(attributes_float, tri + 2);
+      f0 = attribute_data_float(kg, desc, tri + 0);
+      f1 = attribute_data_float(kg, desc, tri + 1);
+      f2 = attribute_data_float(kg, desc, tri + 2);
     }
 
 #ifdef __RAY_DIFFERENTIALS__
@@ -193,7 +193,7 @@ ccl_device float triangle_attribute_float(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float, offset);
+      return attribute_data_float(kg, desc, offset);
     }
     else {
       return 0.0f;
@@ -213,15 +213,15 @@ ccl_device float2 triangle_attribute_float2(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint3 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
 
-      f0 = kernel_data_fetch(attributes_float2, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float2, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float2, desc.offset + tri_vindex.z);
+      f0 = attribute_data_float2(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_float2(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_float2(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
-      f0 = kernel_data_fetch(attributes_float2, tri + 0);
-      f1 = kernel_data_fetch(attributes_float2, tri + 1);
-      f2 = kernel_data_fetch(attributes_float2, tri + 2);
+      f0 = attribute_data_float2(kg, desc, tri + 0);
+      f1 = attribute_data_float2(kg, desc, tri + 1);
+      f2 = attribute_data_float2(kg, desc, tri + 2);
     }
 
 #ifdef __RAY_DIFFERENTIALS__
@@ -244,7 +244,7 @@ ccl_device float2 triangle_attribute_float2(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float2, offset);
+      return attribute_data_float2(kg, desc, offset);
     }
     else {
       return make_float2(0.0f, 0.0f);
@@ -264,15 +264,15 @@ ccl_device float3 triangle_attribute_float3(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint3 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
 
-      f0 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.z);
+      f0 = attribute_data_float3(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_float3(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_float3(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
-      f0 = kernel_data_fetch(attributes_float3, tri + 0);
-      f1 = kernel_data_fetch(attributes_float3, tri + 1);
-      f2 = kernel_data_fetch(attributes_float3, tri + 2);
+      f0 = attribute_data_float3(kg, desc, tri + 0);
+      f1 = attribute_data_float3(kg, desc, tri + 1);
+      f2 = attribute_data_float3(kg, desc, tri + 2);
     }
 
 #ifdef __RAY_DIFFERENTIALS__
@@ -295,7 +295,7 @@ ccl_device float3 triangle_attribute_float3(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float3, offset);
+      return attribute_data_float3(kg, desc, offset);
     }
     else {
       return make_float3(0.0f, 0.0f, 0.0f);
@@ -317,16 +317,16 @@ ccl_device float4 triangle_attribute_float4(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint3 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
 
-      f0 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.z);
+      f0 = attribute_data_float4(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_float4(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_float4(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
       if (desc.element == ATTR_ELEMENT_CORNER) {
-        f0 = kernel_data_fetch(attributes_float4, tri + 0);
-        f1 = kernel_data_fetch(attributes_float4, tri + 1);
-        f2 = kernel_data_fetch(attributes_float4, tri + 2);
+        f0 = attribute_data_float4(kg, desc, tri + 0);
+        f1 = attribute_data_float4(kg, desc, tri + 1);
+        f2 = attribute_data_float4(kg, desc, tri + 2);
       }
       else {
         f0 = color_srgb_to_linear_v4(
@@ -358,7 +358,7 @@ ccl_device float4 triangle_attribute_float4(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float4, offset);
+      return attribute_data_float4(kg, desc, offset);
     }
     else {
       return zero_float4();
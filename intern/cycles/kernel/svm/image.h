@@ -6,14 +6,24 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y, uint flags)
+ccl_device float4 svm_image_texture(KernelGlobals kg,
+                                   int id,
+                                   float x,
+                                   float y,
+                                   uint flags,
+                                   const float2 duv_dx,
+                                   const float2 duv_dy)
 {
   if (id == -1) {
     return make_float4(
         TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
   }
 
+#ifdef __TEXTURE_CACHE__
+  float4 r = kernel_tex_image_interp(kg, id, x, y, duv_dx, duv_dy);
+#else
   float4 r = kernel_tex_image_interp(kg, id, x, y);
+#endif
   const float alpha = r.w;
 
   if ((flags & NODE_IMAGE_ALPHA_UNASSOCIATE) && alpha != 1.0f && alpha != 0.0f) {
@@ -98,7 +108,24 @@ ccl_device_noinline int svm_node_tex_image(
     id = -num_nodes;
   }
 
-  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags);
+  float2 duv_dx = zero_float2();
+  float2 duv_dy = zero_float2();
+#ifdef __TEXTURE_CACHE__
+  /* The texture cache selects the mipmap level from the footprint in texture space. It is only
+   * known when the image is looked up with the default UV map, which is the common case of a UV
+   * mapped image. Other coordinates have a zero footprint and are looked up at full
+   * resolution. */
+  if (id != -1 && (flags & NODE_IMAGE_DEFAULT_UV) &&
+      kernel_data_fetch(texture_info, id).data_type == IMAGE_DATA_TYPE_TEXTURE_CACHE)
+  {
+    const AttributeDescriptor desc = find_attribute(kg, sd, ATTR_STD_UV);
+    if (desc.offset != ATTR_STD_NOT_FOUND) {
+      primitive_surface_attribute_float2(kg, sd, desc, &duv_dx, &duv_dy);
+    }
+  }
+#endif
+
+  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags, duv_dx, duv_dy);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
@@ -192,15 +219,15 @@ ccl_device_noinline void svm_node_tex_image_box(KernelGlobals kg,
   /* Map so that no textures are flipped, rotation is somewhat arbitrary. */
   if (weight.x > 0.0f) {
     float2 uv = make_float2((signed_N.x < 0.0f) ? 1.0f - co.y : co.y, co.z);
-    f += weight.x * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.x * svm_image_texture(kg, id, uv.x, uv.y, flags, zero_float2(), zero_float2());
   }
   if (weight.y > 0.0f) {
     float2 uv = make_float2((signed_N.y > 0.0f) ? 1.0f - co.x : co.x, co.z);
-    f += weight.y * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.y * svm_image_texture(kg, id, uv.x, uv.y, flags, zero_float2(), zero_float2());
   }
   if (weight.z > 0.0f) {
     float2 uv = make_float2((signed_N.z > 0.0f) ? 1.0f - co.y : co.y, co.x);
-    f += weight.z * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.z * svm_image_texture(kg, id, uv.x, uv.y, flags, zero_float2(), zero_float2());
   }
 
   if (stack_valid(out_offset))
@@ -230,7 +257,7 @@ ccl_device_noinline void svm_node_tex_environment(KernelGlobals kg,
   else
     uv = direction_to_mirrorball(co);
 
-  float4 f = svm_image_texture(kg, id, uv.x, uv.y, flags);
+  float4 f = svm_image_texture(kg, id, uv.x, uv.y, flags, zero_float2(), zero_float2());
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
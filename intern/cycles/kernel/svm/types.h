@@ -364,6 +364,8 @@ typedef enum NodeImageProjection {
 typedef enum NodeImageFlags {
   NODE_IMAGE_COMPRESS_AS_SRGB = 1,
   NODE_IMAGE_ALPHA_UNASSOCIATE = 2,
+  /* The coordinates are the default UV map, so its differentials give the texture footprint. */
+  NODE_IMAGE_DEFAULT_UV = 4,
 } NodeImageFlags;
 
 typedef enum NodeEnvironmentProjection {
@@ -208,6 +208,7 @@ CCL_NAMESPACE_BEGIN
 #    define __PATH_GUIDING__
 #  endif
 #  define __VOLUME_RECORD_ALL__
+#  define __TEXTURE_CACHE__
 #endif /* !__KERNEL_GPU__ */
 
 /* MNEE caused "Compute function exceeds available temporary registers" in macOS < 13 due to a bug
@@ -914,6 +915,17 @@ typedef enum AttributeStandard {
 typedef enum AttributeFlag {
   ATTR_FINAL_SIZE = (1 << 0),
   ATTR_SUBDIVIDED = (1 << 1),
+
+  /* Data is stored in the attributes_quantized array, with one of these encodings. */
+  ATTR_QUANTIZED_HALF = (1 << 2),
+  ATTR_QUANTIZED_OCTAHEDRAL = (1 << 3),
+  ATTR_QUANTIZED_NORM8 = (1 << 4),
+  ATTR_QUANTIZED_NORM16 = (1 << 5),
+  /* Normalized values are in [-1, 1] instead of [0, 1]. */
+  ATTR_QUANTIZED_SIGNED = (1 << 6),
+
+  ATTR_QUANTIZED = (ATTR_QUANTIZED_HALF | ATTR_QUANTIZED_OCTAHEDRAL | ATTR_QUANTIZED_NORM8 |
+                    ATTR_QUANTIZED_NORM16),
 } AttributeFlag;
 
 typedef struct AttributeDescriptor {
@@ -10,6 +10,7 @@
 
 #include "util/foreach.h"
 #include "util/log.h"
+#include "util/quantize.h"
 #include "util/transform.h"
 
 CCL_NAMESPACE_BEGIN
@@ -47,6 +48,10 @@ Attribute::~Attribute()
 void Attribute::resize(Geometry *geom, AttributePrimitive prim, bool reserve_only)
 {
   if (element != ATTR_ELEMENT_VOXEL) {
+    if (shared_data && !reserve_only && shared_size == buffer_size(geom, prim)) {
+      return;
+    }
+    ensure_unique();
     if (reserve_only) {
       buffer.reserve(buffer_size(geom, prim));
     }
@@ -59,10 +64,42 @@ void Attribute::resize(Geometry *geom, AttributePrimitive prim, bool reserve_onl
 void Attribute::resize(size_t num_elements)
 {
   if (element != ATTR_ELEMENT_VOXEL) {
+    if (shared_data && shared_size == num_elements * data_sizeof()) {
+      return;
+    }
+    ensure_unique();
     buffer.resize(num_elements * data_sizeof(), 0);
   }
 }
 
+void Attribute::set_shared_data(const void *data,
+                                size_t size,
+                                unique_ptr<AttributeSharedData> owner)
+{
+  assert(element != ATTR_ELEMENT_VOXEL);
+
+  /* Release the memory of the buffer, clearing it would keep its capacity. */
+  vector<char>().swap(buffer);
+
+  shared_data = static_cast<const char *>(data);
+  shared_size = size;
+  shared_owner = std::move(owner);
+  modified = true;
+}
+
+void Attribute::ensure_unique()
+{
+  if (shared_data == nullptr) {
+    return;
+  }
+
+  buffer.assign(shared_data, shared_data + shared_size);
+
+  shared_data = nullptr;
+  shared_size = 0;
+  shared_owner.reset();
+}
+
 void Attribute::add(const float &f)
 {
   assert(data_sizeof() == sizeof(float));
@@ -70,6 +107,7 @@ void Attribute::add(const float &f)
   char *data = (char *)&f;
   size_t size = sizeof(f);
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -84,6 +122,7 @@ void Attribute::add(const uchar4 &f)
   char *data = (char *)&f;
   size_t size = sizeof(f);
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -98,6 +137,7 @@ void Attribute::add(const float2 &f)
   char *data = (char *)&f;
   size_t size = sizeof(f);
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -112,6 +152,7 @@ void Attribute::add(const float3 &f)
   char *data = (char *)&f;
   size_t size = sizeof(f);
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -126,6 +167,7 @@ void Attribute::add(const Transform &f)
   char *data = (char *)&f;
   size_t size = sizeof(f);
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -137,6 +179,7 @@ void Attribute::add(const char *data)
 {
   size_t size = data_sizeof();
 
+  ensure_unique();
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
   }
@@ -152,12 +195,22 @@ void Attribute::set_data_from(Attribute &&other)
 
   this->flags = other.flags;
 
-  if (this->buffer.size() != other.buffer.size()) {
+  const Attribute &old_attr = *this;
+  const Attribute &new_attr = other;
+  const size_t size = new_attr.data_size();
+  const bool changed = old_attr.data_size() != size ||
+                       memcmp(old_attr.data(), new_attr.data(), size) != 0;
+
+  /* Also take over unchanged data when it's shared, to free the copy in this buffer. */
+  if (changed || (other.shared_data && !this->shared_data)) {
     this->buffer = std::move(other.buffer);
-    modified = true;
+    this->shared_data = other.shared_data;
+    this->shared_size = other.shared_size;
+    this->shared_owner = std::move(other.shared_owner);
+    other.shared_data = nullptr;
+    other.shared_size = 0;
   }
-  else if (memcmp(this->data(), other.data(), other.buffer.size()) != 0) {
-    this->buffer = std::move(other.buffer);
+  if (changed) {
     modified = true;
   }
 }
@@ -195,7 +248,7 @@ size_t Attribute::data_sizeof() const
 size_t Attribute::element_size(Geometry *geom, AttributePrimitive prim) const
 {
   if (flags & ATTR_FINAL_SIZE) {
-    return buffer.size() / data_sizeof();
+    return data_size() / data_sizeof();
   }
 
   size_t size = 0;
@@ -973,4 +1026,114 @@ void AttributeRequestSet::clear()
   requests.clear();
 }
 
+/* Attribute Quantization */
+
+static float round_trip_half(const float f)
+{
+  return half_bits_to_float(float_to_half_bits(f));
+}
+
+static float quantization_error(const float a, const float b)
+{
+  return fabsf(a - b);
+}
+
+template<typename T> static float quantization_error(const T a, const T b)
+{
+  return reduce_max(fabs(a - b));
+}
+
+template<typename T, typename RoundTripFunc>
+static bool quantization_within_tolerance(const T *data,
+                                          const size_t size,
+                                          const float tolerance,
+                                          const RoundTripFunc &round_trip)
+{
+  for (size_t k = 0; k < size; k++) {
+    /* Negated comparison so that NaN values are never quantized. */
+    if (!(quantization_error(round_trip(data[k]), data[k]) <= tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint choose_attribute_quantization(const Attribute &attr,
+                                   const size_t size,
+                                   const float tolerance)
+{
+  if (attr.type == TypeDesc::TypeFloat) {
+    const float *data = attr.data_float();
+
+    float min_value = 0.0f, max_value = 0.0f;
+    for (size_t k = 0; k < size; k++) {
+      min_value = min(min_value, data[k]);
+      max_value = max(max_value, data[k]);
+    }
+
+    if (min_value >= -1.0f && max_value <= 1.0f) {
+      const bool is_signed = (min_value < 0.0f);
+      for (const bool is_8bit : {true, false}) {
+        if (quantization_within_tolerance(data, size, tolerance, [=](const float f) {
+              return norm_to_float(float_to_norm(f, is_8bit, is_signed), is_8bit, is_signed);
+            }))
+        {
+          return (is_8bit ? ATTR_QUANTIZED_NORM8 : ATTR_QUANTIZED_NORM16) |
+                 (is_signed ? ATTR_QUANTIZED_SIGNED : 0);
+        }
+      }
+    }
+
+    return quantization_within_tolerance(data, size, tolerance, round_trip_half) ?
+               ATTR_QUANTIZED_HALF :
+               0;
+  }
+
+  if (attr.type == TypeFloat2) {
+    return quantization_within_tolerance(attr.data_float2(),
+                                         size,
+                                         tolerance,
+                                         [](const float2 f) {
+                                           return make_float2(round_trip_half(f.x),
+                                                              round_trip_half(f.y));
+                                         }) ?
+               ATTR_QUANTIZED_HALF :
+               0;
+  }
+
+  if (attr.type == TypeFloat4 || attr.type == TypeRGBA) {
+    return quantization_within_tolerance(attr.data_float4(),
+                                         size,
+                                         tolerance,
+                                         [](const float4 f) {
+                                           return make_float4(round_trip_half(f.x),
+                                                              round_trip_half(f.y),
+                                                              round_trip_half(f.z),
+                                                              round_trip_half(f.w));
+                                         }) ?
+               ATTR_QUANTIZED_HALF :
+               0;
+  }
+
+  /* Normals, tangents and other unit vectors fit in the octahedral encoding. */
+  const float3 *data = attr.data_float3();
+  if (quantization_within_tolerance(data, size, tolerance, [](const float3 f) {
+        return octahedral_to_float3(float3_to_octahedral(f));
+      }))
+  {
+    return ATTR_QUANTIZED_OCTAHEDRAL;
+  }
+
+  return quantization_within_tolerance(data,
+                                       size,
+                                       tolerance,
+                                       [](const float3 f) {
+                                         return make_float3(round_trip_half(f.x),
+                                                            round_trip_half(f.y),
+                                                            round_trip_half(f.z));
+                                       }) ?
+             ATTR_QUANTIZED_HALF :
+             0;
+}
+
 CCL_NAMESPACE_END
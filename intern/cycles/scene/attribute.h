@@ -13,6 +13,7 @@
 #include "util/param.h"
 #include "util/set.h"
 #include "util/types.h"
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -37,6 +38,16 @@ struct Transform;
 
 enum AttrKernelDataType { FLOAT = 0, FLOAT2 = 1, FLOAT3 = 2, FLOAT4 = 3, UCHAR4 = 4, NUM = 5 };
 
+/* AttributeSharedData
+ *
+ * Keeps data alive which the host application shares with an attribute instead of copying it
+ * into the attribute buffer. Destroyed when the attribute no longer references the data. */
+
+class AttributeSharedData {
+ public:
+  virtual ~AttributeSharedData() = default;
+};
+
 /* Attribute
  *
  * Arbitrary data layers on meshes.
@@ -54,6 +65,16 @@ class Attribute {
 
   bool modified;
 
+  /* Reduced precision encoding of the data on the device as ATTR_QUANTIZED flags, or zero for
+   * full precision. Chosen by the geometry manager whenever the attribute is modified. */
+  uint quantization = 0;
+
+  /* Read-only data used instead of the buffer when shared by the host application, owned by
+   * shared_owner. It is copied into the buffer as soon as the attribute is modified. */
+  const char *shared_data = nullptr;
+  size_t shared_size = 0;
+  unique_ptr<AttributeSharedData> shared_owner;
+
   Attribute(ustring name,
             TypeDesc type,
             AttributeElement element,
@@ -72,8 +93,20 @@ class Attribute {
   size_t element_size(Geometry *geom, AttributePrimitive prim) const;
   size_t buffer_size(Geometry *geom, AttributePrimitive prim) const;
 
+  /* Size of the data in bytes, whether shared or stored in the buffer. */
+  size_t data_size() const
+  {
+    return (shared_data) ? shared_size : buffer.size();
+  }
+
+  /* Use data of the host application without copying it, see #shared_data. */
+  void set_shared_data(const void *data, size_t size, unique_ptr<AttributeSharedData> owner);
+  /* Copy shared data into the buffer, so that it can be modified. */
+  void ensure_unique();
+
   char *data()
   {
+    ensure_unique();
     return (buffer.size()) ? &buffer[0] : NULL;
   }
   float2 *data_float2()
@@ -116,6 +149,9 @@ class Attribute {
 
   const char *data() const
   {
+    if (shared_data) {
+      return shared_data;
+    }
     return (buffer.size()) ? &buffer[0] : NULL;
   }
   const float2 *data_float2() const
@@ -138,6 +174,11 @@ class Attribute {
     assert(data_sizeof() == sizeof(float));
     return (const float *)data();
   }
+  const uchar4 *data_uchar4() const
+  {
+    assert(data_sizeof() == sizeof(uchar4));
+    return (const uchar4 *)data();
+  }
   const Transform *data_transform() const
   {
     assert(data_sizeof() == sizeof(Transform));
@@ -170,6 +211,10 @@ class Attribute {
   void get_uv_tiles(Geometry *geom, AttributePrimitive prim, unordered_set<int> &tiles) const;
 };
 
+/* Smallest ATTR_QUANTIZED_* encoding for which every one of the first size values of the
+ * attribute decodes to within the tolerance, or 0 if none does. */
+uint choose_attribute_quantization(const Attribute &attr, size_t size, float tolerance);
+
 /* Attribute Set
  *
  * Set of attributes on a mesh. */
@@ -61,6 +61,8 @@ class DeviceScene {
   device_vector<packed_float3> attributes_float3;
   device_vector<float4> attributes_float4;
   device_vector<uchar4> attributes_uchar4;
+  /* Attributes of any type stored with reduced precision, see #AttributeFlag. */
+  device_vector<uint> attributes_quantized;
 
   /* lights */
   device_vector<KernelLightDistribution> light_distribution;
@@ -66,6 +66,9 @@ Geometry::Geometry(const NodeType *node_type, const Type type)
   bvh = NULL;
   attr_map_offset = 0;
   prim_offset = 0;
+
+  bvh_num_refits = 0;
+  bvh_build_area = 0.0f;
 }
 
 Geometry::~Geometry()
@@ -122,6 +125,22 @@ bool Geometry::need_build_bvh(BVHLayout layout) const
          layout == BVH_LAYOUT_MULTI_EMBREEGPU || layout == BVH_LAYOUT_MULTI_EMBREEGPU_EMBREE;
 }
 
+/* Refitting keeps the topology of the BVH built for the original vertex positions, so its quality
+ * goes down as the geometry deforms further away from them. These limits are rough estimates. */
+static const int BVH_MAX_REFITS = 16;
+static const float BVH_MAX_REFIT_AREA_RATIO = 2.0f;
+
+bool Geometry::bvh_refit_degraded() const
+{
+  if (bvh_num_refits >= BVH_MAX_REFITS) {
+    return true;
+  }
+
+  const float area = bounds.safe_area();
+  return area > bvh_build_area * BVH_MAX_REFIT_AREA_RATIO ||
+         area * BVH_MAX_REFIT_AREA_RATIO < bvh_build_area;
+}
+
 bool Geometry::is_instanced() const
 {
   /* Currently we treat subsurface objects as instanced.
@@ -583,6 +602,17 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     dscene->attributes_uchar4.tag_modified();
   }
 
+  /* Quantized attributes of all types share one array, so any change in the layout of the other
+   * arrays may move them too. */
+  if (device_update_flags & ATTRS_NEED_REALLOC) {
+    dscene->attributes_quantized.tag_realloc();
+  }
+  else if (device_update_flags & (ATTR_FLOAT_MODIFIED | ATTR_FLOAT2_MODIFIED |
+                                  ATTR_FLOAT3_MODIFIED | ATTR_FLOAT4_MODIFIED))
+  {
+    dscene->attributes_quantized.tag_modified();
+  }
+
   if (device_update_flags & DEVICE_MESH_DATA_MODIFIED) {
     /* if anything else than vertices or shaders are modified, we would need to reallocate, so
      * these are the only arrays that can be updated */
@@ -1053,6 +1083,7 @@ void GeometryManager::device_update(Device *device,
   dscene->attributes_float3.clear_modified();
   dscene->attributes_float4.clear_modified();
   dscene->attributes_uchar4.clear_modified();
+  dscene->attributes_quantized.clear_modified();
 }
 
 void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool force_free)
@@ -1083,6 +1114,7 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool forc
   dscene->attributes_float3.free_if_need_realloc(force_free);
   dscene->attributes_float4.free_if_need_realloc(force_free);
   dscene->attributes_uchar4.free_if_need_realloc(force_free);
+  dscene->attributes_quantized.free_if_need_realloc(force_free);
 
   /* Signal for shaders like displacement not to do ray tracing. */
   dscene->data.bvh.bvh_layout = BVH_LAYOUT_NONE;
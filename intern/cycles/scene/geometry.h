@@ -104,6 +104,11 @@ class Geometry : public Node {
   size_t attr_map_offset;
   size_t prim_offset;
 
+  /* Number of times the BVH of this geometry was refit since it was last built, and the surface
+   * area of the bounds at that build. Used to detect when refitting degraded the BVH. */
+  int bvh_num_refits;
+  float bvh_build_area;
+
   /* Shader Properties */
   bool has_volume;         /* Set in the device_update_flags(). */
   bool has_surface_bssrdf; /* Set in the device_update_flags(). */
@@ -159,6 +164,10 @@ class Geometry : public Node {
    */
   bool need_build_bvh(BVHLayout layout) const;
 
+  /* Check whether the BVH should be rebuilt rather than refit, because the nodes are likely to
+   * overlap too much after many refits or a large change of the bounds since it was built. */
+  bool bvh_refit_degraded() const;
+
   /* Test if the geometry should be treated as instanced. */
   bool is_instanced() const;
 
@@ -289,7 +298,9 @@ class GeometryManager {
                                               size_t &attr_float4_offset,
                                               device_vector<uchar4> &attr_uchar4,
                                               size_t &attr_uchar4_offset,
-                                              Attribute *mattr,
+                                              device_vector<uint> &attr_quantized,
+                                              size_t &attr_quantized_offset,
+                                              const Attribute *mattr,
                                               AttributePrimitive prim,
                                               TypeDesc &type,
                                               AttributeDescriptor &desc);
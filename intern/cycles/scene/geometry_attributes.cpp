@@ -29,6 +29,7 @@
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/quantize.h"
 #include "util/task.h"
 
 CCL_NAMESPACE_BEGIN
@@ -273,6 +274,132 @@ void GeometryManager::update_svm_attributes(Device *,
   dscene->attributes_map.copy_to_device();
 }
 
+/* Attribute Quantization
+ *
+ * Attributes of triangle meshes may be stored with reduced precision in the attributes_quantized
+ * array, which the kernel decodes when looking them up. See choose_attribute_quantization() for
+ * how the encoding is chosen. */
+
+static uint pack_half2(const float a, const float b)
+{
+  return float_to_half_bits(a) | (float_to_half_bits(b) << 16);
+}
+
+/* Choose the encoding of a modified attribute, returns true if it changed. */
+static bool update_attribute_quantization(Scene *scene,
+                                          Geometry *geom,
+                                          Attribute *mattr,
+                                          AttributePrimitive prim)
+{
+  if (!mattr || !mattr->modified) {
+    return false;
+  }
+
+  uint quantization = 0;
+
+  /* Only the lookup of triangle attributes decodes quantized data, so leave out subdivision
+   * surfaces, motion and voxel data and the attributes of other geometry types. */
+  if (scene->params.use_attribute_quantization && prim == ATTR_PRIM_GEOMETRY && geom->is_mesh() &&
+      static_cast<Mesh *>(geom)->get_num_subd_faces() == 0 &&
+      (mattr->flags & ATTR_SUBDIVIDED) == 0 &&
+      (mattr->element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_CORNER | ATTR_ELEMENT_FACE)) &&
+      mattr->type != TypeDesc::TypeMatrix)
+  {
+    quantization = choose_attribute_quantization(
+        *mattr, mattr->element_size(geom, prim), scene->params.attribute_quantization_tolerance);
+  }
+
+  const bool changed = (quantization != mattr->quantization);
+  mattr->quantization = quantization;
+  return changed;
+}
+
+/* Size in bytes of one element in the attributes_quantized array. */
+static size_t quantized_element_size(const Attribute &attr)
+{
+  if (attr.quantization & ATTR_QUANTIZED_NORM8) {
+    return 1;
+  }
+  if (attr.quantization & ATTR_QUANTIZED_NORM16) {
+    return 2;
+  }
+  if (attr.quantization & ATTR_QUANTIZED_OCTAHEDRAL) {
+    return 4;
+  }
+  /* Half floats, with float3 padded to four components. */
+  if (attr.type == TypeDesc::TypeFloat) {
+    return 2;
+  }
+  if (attr.type == TypeFloat2) {
+    return 4;
+  }
+  return 8;
+}
+
+static void write_quantized_bits(uint *words,
+                                 const size_t bit_offset,
+                                 const uint num_bits,
+                                 const uint value)
+{
+  uint &word = words[bit_offset / 32];
+  const uint shift = bit_offset % 32;
+  const uint mask = ((1u << num_bits) - 1) << shift;
+  word = (word & ~mask) | (value << shift);
+}
+
+/* Encode the attribute data into the array, starting at the given element index. */
+static void quantize_attribute_data(const Attribute &attr,
+                                    const size_t size,
+                                    uint *words,
+                                    const size_t index)
+{
+  const uint flags = attr.quantization;
+
+  if (attr.type == TypeDesc::TypeFloat) {
+    const float *data = attr.data_float();
+    if (flags & (ATTR_QUANTIZED_NORM8 | ATTR_QUANTIZED_NORM16)) {
+      const bool is_8bit = (flags & ATTR_QUANTIZED_NORM8) != 0;
+      const bool is_signed = (flags & ATTR_QUANTIZED_SIGNED) != 0;
+      const uint num_bits = is_8bit ? 8 : 16;
+      for (size_t k = 0; k < size; k++) {
+        write_quantized_bits(
+            words, (index + k) * num_bits, num_bits, float_to_norm(data[k], is_8bit, is_signed));
+      }
+    }
+    else {
+      for (size_t k = 0; k < size; k++) {
+        write_quantized_bits(words, (index + k) * 16, 16, float_to_half_bits(data[k]));
+      }
+    }
+  }
+  else if (attr.type == TypeFloat2) {
+    const float2 *data = attr.data_float2();
+    for (size_t k = 0; k < size; k++) {
+      words[index + k] = pack_half2(data[k].x, data[k].y);
+    }
+  }
+  else if (attr.type == TypeFloat4 || attr.type == TypeRGBA) {
+    const float4 *data = attr.data_float4();
+    for (size_t k = 0; k < size; k++) {
+      words[(index + k) * 2 + 0] = pack_half2(data[k].x, data[k].y);
+      words[(index + k) * 2 + 1] = pack_half2(data[k].z, data[k].w);
+    }
+  }
+  else if (flags & ATTR_QUANTIZED_OCTAHEDRAL) {
+    const float3 *data = attr.data_float3();
+    for (size_t k = 0; k < size; k++) {
+      words[index + k] = float3_to_octahedral(data[k]);
+    }
+  }
+  else {
+    const float3 *data = attr.data_float3();
+    for (size_t k = 0; k < size; k++) {
+      words[(index + k) * 2 + 0] = pack_half2(data[k].x, data[k].y);
+      words[(index + k) * 2 + 1] = pack_half2(data[k].z, 0.0f);
+    }
+  }
+}
+
 void GeometryManager::update_attribute_element_offset(Geometry *geom,
                                                       device_vector<float> &attr_float,
                                                       size_t &attr_float_offset,
@@ -284,7 +411,9 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
                                                       size_t &attr_float4_offset,
                                                       device_vector<uchar4> &attr_uchar4,
                                                       size_t &attr_uchar4_offset,
-                                                      Attribute *mattr,
+                                                      device_vector<uint> &attr_quantized,
+                                                      size_t &attr_quantized_offset,
+                                                      const Attribute *mattr,
                                                       AttributePrimitive prim,
                                                       TypeDesc &type,
                                                       AttributeDescriptor &desc)
@@ -292,7 +421,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
   if (mattr) {
     /* store element and type */
     desc.element = mattr->element;
-    desc.flags = mattr->flags;
+    desc.flags = mattr->flags | mattr->quantization;
     type = mattr->type;
 
     /* store attribute data in arrays */
@@ -303,11 +432,24 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
     if (mattr->element == ATTR_ELEMENT_VOXEL) {
       /* store slot in offset value */
-      ImageHandle &handle = mattr->data_voxel();
+      const ImageHandle &handle = mattr->data_voxel();
       offset = handle.svm_slot();
     }
+    else if (mattr->quantization) {
+      /* Offset in bytes, aligned so that it can be stored as an element index. */
+      const size_t element_size = quantized_element_size(*mattr);
+      attr_quantized_offset = align_up(attr_quantized_offset, element_size);
+      offset = attr_quantized_offset / element_size;
+
+      assert(attr_quantized.size() * sizeof(uint) >= attr_quantized_offset + size * element_size);
+      if (mattr->modified) {
+        quantize_attribute_data(*mattr, size, attr_quantized.data(), offset);
+        attr_quantized.tag_modified();
+      }
+      attr_quantized_offset += size * element_size;
+    }
     else if (mattr->element == ATTR_ELEMENT_CORNER_BYTE) {
-      uchar4 *data = mattr->data_uchar4();
+      const uchar4 *data = mattr->data_uchar4();
       offset = attr_uchar4_offset;
 
       assert(attr_uchar4.size() >= offset + size);
@@ -320,7 +462,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_uchar4_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeFloat) {
-      float *data = mattr->data_float();
+      const float *data = mattr->data_float();
       offset = attr_float_offset;
 
       assert(attr_float.size() >= offset + size);
@@ -333,7 +475,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float_offset += size;
     }
     else if (mattr->type == TypeFloat2) {
-      float2 *data = mattr->data_float2();
+      const float2 *data = mattr->data_float2();
       offset = attr_float2_offset;
 
       assert(attr_float2.size() >= offset + size);
@@ -346,7 +488,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float2_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeMatrix) {
-      Transform *tfm = mattr->data_transform();
+      const Transform *tfm = mattr->data_transform();
       offset = attr_float4_offset;
 
       assert(attr_float4.size() >= offset + size * 3);
@@ -359,7 +501,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float4_offset += size * 3;
     }
     else if (mattr->type == TypeFloat4 || mattr->type == TypeRGBA) {
-      float4 *data = mattr->data_float4();
+      const float4 *data = mattr->data_float4();
       offset = attr_float4_offset;
 
       assert(attr_float4.size() >= offset + size);
@@ -372,7 +514,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float4_offset += size;
     }
     else {
-      float3 *data = mattr->data_float3();
+      const float3 *data = mattr->data_float3();
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size);
@@ -453,7 +595,8 @@ static void update_attribute_element_size(Geometry *geom,
                                           size_t *attr_float2_size,
                                           size_t *attr_float3_size,
                                           size_t *attr_float4_size,
-                                          size_t *attr_uchar4_size)
+                                          size_t *attr_uchar4_size,
+                                          size_t *attr_quantized_size)
 {
   if (mattr) {
     size_t size = mattr->element_size(geom, prim);
@@ -461,6 +604,11 @@ static void update_attribute_element_size(Geometry *geom,
     if (mattr->element == ATTR_ELEMENT_VOXEL) {
       /* pass */
     }
+    else if (mattr->quantization) {
+      /* Size in bytes, see update_attribute_element_offset. */
+      const size_t element_size = quantized_element_size(*mattr);
+      *attr_quantized_size = align_up(*attr_quantized_size, element_size) + size * element_size;
+    }
     else if (mattr->element == ATTR_ELEMENT_CORNER_BYTE) {
       *attr_uchar4_size += size;
     }
@@ -555,6 +703,8 @@ void GeometryManager::device_update_attributes(Device *device,
   size_t attr_float3_size = 0;
   size_t attr_float4_size = 0;
   size_t attr_uchar4_size = 0;
+  size_t attr_quantized_size = 0;
+  bool quantization_changed = false;
 
   for (size_t i = 0; i < scene->geometry.size(); i++) {
     Geometry *geom = scene->geometry[i];
@@ -562,6 +712,8 @@ void GeometryManager::device_update_attributes(Device *device,
     foreach (AttributeRequest &req, attributes.requests) {
       Attribute *attr = geom->attributes.find(req);
 
+      quantization_changed |= update_attribute_quantization(scene, geom, attr, ATTR_PRIM_GEOMETRY);
+
       update_attribute_element_size(geom,
                                     attr,
                                     ATTR_PRIM_GEOMETRY,
@@ -569,7 +721,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                     &attr_float2_size,
                                     &attr_float3_size,
                                     &attr_float4_size,
-                                    &attr_uchar4_size);
+                                    &attr_uchar4_size,
+                                    &attr_quantized_size);
 
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -582,7 +735,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       &attr_float2_size,
                                       &attr_float3_size,
                                       &attr_float4_size,
-                                      &attr_uchar4_size);
+                                      &attr_uchar4_size,
+                                      &attr_quantized_size);
       }
     }
   }
@@ -598,7 +752,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                     &attr_float2_size,
                                     &attr_float3_size,
                                     &attr_float4_size,
-                                    &attr_uchar4_size);
+                                    &attr_uchar4_size,
+                                    &attr_quantized_size);
     }
   }
 
@@ -608,12 +763,26 @@ void GeometryManager::device_update_attributes(Device *device,
   dscene->attributes_float4.alloc(attr_float4_size);
   dscene->attributes_uchar4.alloc(attr_uchar4_size);
 
+  /* Quantized attributes of all types share one array, whose size also depends on the chosen
+   * encodings. Copy all of them when any of them moved. When an attribute switched between full
+   * and reduced precision, the layout of all arrays and the attribute map changed. */
+  const size_t attr_quantized_words = divide_up(attr_quantized_size, sizeof(uint));
+  const bool quantized_need_realloc = dscene->attributes_quantized.need_realloc() ||
+                                      dscene->attributes_quantized.size() !=
+                                          attr_quantized_words ||
+                                      quantization_changed;
+  dscene->attributes_quantized.alloc(attr_quantized_words);
+
+  if (quantization_changed) {
+    dscene->attributes_map.tag_realloc();
+  }
+
   /* The order of those flags needs to match that of AttrKernelDataType. */
   const bool attributes_need_realloc[AttrKernelDataType::NUM] = {
-      dscene->attributes_float.need_realloc(),
-      dscene->attributes_float2.need_realloc(),
-      dscene->attributes_float3.need_realloc(),
-      dscene->attributes_float4.need_realloc(),
+      dscene->attributes_float.need_realloc() || quantization_changed,
+      dscene->attributes_float2.need_realloc() || quantization_changed,
+      dscene->attributes_float3.need_realloc() || quantization_changed,
+      dscene->attributes_float4.need_realloc() || quantization_changed,
       dscene->attributes_uchar4.need_realloc(),
   };
 
@@ -622,6 +791,7 @@ void GeometryManager::device_update_attributes(Device *device,
   size_t attr_float3_offset = 0;
   size_t attr_float4_offset = 0;
   size_t attr_uchar4_offset = 0;
+  size_t attr_quantized_offset = 0;
 
   /* Fill in attributes. */
   for (size_t i = 0; i < scene->geometry.size(); i++) {
@@ -635,7 +805,8 @@ void GeometryManager::device_update_attributes(Device *device,
 
       if (attr) {
         /* force a copy if we need to reallocate all the data */
-        attr->modified |= attributes_need_realloc[Attribute::kernel_type(*attr)];
+        attr->modified |= attributes_need_realloc[Attribute::kernel_type(*attr)] ||
+                          (attr->quantization && quantized_need_realloc);
       }
 
       update_attribute_element_offset(geom,
@@ -649,6 +820,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr_float4_offset,
                                       dscene->attributes_uchar4,
                                       attr_uchar4_offset,
+                                      dscene->attributes_quantized,
+                                      attr_quantized_offset,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
@@ -674,6 +847,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                         attr_float4_offset,
                                         dscene->attributes_uchar4,
                                         attr_uchar4_offset,
+                                        dscene->attributes_quantized,
+                                        attr_quantized_offset,
                                         subd_attr,
                                         ATTR_PRIM_SUBD,
                                         req.subd_type,
@@ -709,6 +884,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr_float4_offset,
                                       dscene->attributes_uchar4,
                                       attr_uchar4_offset,
+                                      dscene->attributes_quantized,
+                                      attr_quantized_offset,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
@@ -743,6 +920,7 @@ void GeometryManager::device_update_attributes(Device *device,
   dscene->attributes_float3.copy_to_device_if_modified();
   dscene->attributes_float4.copy_to_device_if_modified();
   dscene->attributes_uchar4.copy_to_device_if_modified();
+  dscene->attributes_quantized.copy_to_device_if_modified();
 
   if (progress.get_cancel()) {
     return;
@@ -71,12 +71,16 @@ void Geometry::compute_bvh(Device *device,
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    /* The degradation limits only apply to BVHs that are expected to be refit many times, see
+     * #SceneParams::use_bvh_refit. */
+    const bool refit_degraded = params->use_bvh_refit && bvh_refit_degraded();
+    if (bvh && !need_update_rebuild && !refit_degraded) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->replace_geometry(geometry, objects);
 
       device->build_bvh(bvh, *progress, true);
+      bvh_num_refits++;
     }
     else {
       progress->set_status(msg, "Building BVH");
@@ -84,6 +88,7 @@ void Geometry::compute_bvh(Device *device,
       BVHParams bparams;
       bparams.use_spatial_split = params->use_bvh_spatial_split;
       bparams.use_compact_structure = params->use_bvh_compact_structure;
+      bparams.use_refit = params->use_bvh_refit;
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
@@ -96,6 +101,8 @@ void Geometry::compute_bvh(Device *device,
       delete bvh;
       bvh = BVH::create(bparams, geometry, objects, device);
       MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+      bvh_num_refits = 0;
+      bvh_build_area = bounds.safe_area();
     }
   }
 
@@ -116,6 +123,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.bvh_layout = BVHParams::best_bvh_layout(
       scene->params.bvh_layout, device->get_bvh_layout_mask(dscene->data.kernel_features));
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
+  bparams.use_refit = scene->params.use_bvh_refit;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
@@ -126,9 +134,14 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* The Embree scene BVH can only be refit when the objects in it did not change, only the
+   * vertices of their geometry. It rebuilds the BVH of geometry that degraded too much itself. */
+  const bool can_refit_embree = bparams.use_refit &&
+                                bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE &&
+                                (update_flags & (TRANSFORM_MODIFIED | VISIBILITY_MODIFIED)) == 0;
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL || can_refit_embree);
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
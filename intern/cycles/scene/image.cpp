@@ -20,6 +20,8 @@
 #include "util/texture.h"
 #include "util/unique_ptr.h"
 
+#include <OpenImageIO/texture.h>
+
 #ifdef WITH_OSL
 #  include <OSL/oslexec.h>
 #endif
@@ -55,6 +57,8 @@ const char *name_from_type(ImageDataType type)
       return "nanovdb_fpn";
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
       return "nanovdb_fp16";
+    case IMAGE_DATA_TYPE_TEXTURE_CACHE:
+      return "texture_cache";
     case IMAGE_DATA_NUM_TYPES:
       assert(!"System enumerator type, should never be used");
       return "";
@@ -308,10 +312,14 @@ ImageManager::ImageManager(const DeviceInfo &info)
 {
   need_update_ = true;
   osl_texture_system = NULL;
+  texture_cache = NULL;
   animation_frame = 0;
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+
+  /* The kernel calls into OpenImageIO for lookups, which is only possible on the CPU. */
+  texture_cache_supported = (info.type == DEVICE_CPU);
 }
 
 ImageManager::~ImageManager()
@@ -319,6 +327,8 @@ ImageManager::~ImageManager()
   for (size_t slot = 0; slot < images.size(); slot++) {
     assert(!images[slot]);
   }
+
+  texture_cache_free();
 }
 
 void ImageManager::set_osl_texture_system(void *texture_system)
@@ -508,7 +518,7 @@ void ImageManager::remove_image_user(size_t slot)
   }
 }
 
-static bool image_associate_alpha(ImageManager::Image *img)
+static bool image_associate_alpha(const ImageManager::Image *img)
 {
   /* For typical RGBA images we let OIIO convert to associated alpha,
    * but some types we want to leave the RGB channels untouched. */
@@ -675,6 +685,82 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+void ImageManager::texture_cache_init(Scene *scene)
+{
+  if (!(scene->params.use_texture_cache && texture_cache_supported &&
+        scene->params.shadingsystem == SHADINGSYSTEM_SVM))
+  {
+    return;
+  }
+
+  if (!texture_cache) {
+    TextureSystem *ts = TextureSystem::create(false);
+    /* Untiled and unmipmapped files are split into tiles and get their mipmap levels generated
+     * on the fly, pre-processed .tx files avoid that work. */
+    ts->attribute("automip", 1);
+    ts->attribute("autotile", 64);
+    ts->attribute("gray_to_rgb", 1);
+    texture_cache = ts;
+  }
+
+  ((TextureSystem *)texture_cache)
+      ->attribute("max_memory_MB", float(max(scene->params.texture_cache_size, 1)));
+}
+
+void ImageManager::texture_cache_free()
+{
+  if (!texture_cache) {
+    return;
+  }
+
+  TextureSystem *ts = (TextureSystem *)texture_cache;
+  VLOG_INFO << "Texture cache statistics:\n" << ts->getstats(1);
+  TextureSystem::destroy(ts);
+  texture_cache = NULL;
+}
+
+bool ImageManager::use_texture_cache(const Image *img) const
+{
+  if (!texture_cache || img->builtin || img->loader->osl_filepath().empty()) {
+    return false;
+  }
+
+  const ImageMetaData &metadata = img->metadata;
+  if (metadata.channels == 0 || metadata.depth > 1) {
+    return false;
+  }
+
+  /* Pixels are read as stored in the file, so only color spaces that need no conversion on
+   * load can be used. sRGB is converted by the kernel. */
+  if (metadata.colorspace != u_colorspace_raw && metadata.colorspace != u_colorspace_srgb) {
+    return false;
+  }
+
+  /* The texture system always associates alpha. */
+  const bool has_alpha = (metadata.channels == 2 || metadata.channels >= 4);
+  if (has_alpha && !image_associate_alpha(img)) {
+    return false;
+  }
+
+  return true;
+}
+
+void ImageManager::device_load_image_texture_cache(Image *img)
+{
+  TextureSystem *ts = (TextureSystem *)texture_cache;
+
+  thread_scoped_lock device_lock(device_mutex);
+  TextureCacheImage *cache_image = (TextureCacheImage *)img->mem->alloc(
+      sizeof(TextureCacheImage), 0);
+  cache_image->texture_system = ts;
+  cache_image->texture_handle = ts->get_texture_handle(img->loader->osl_filepath());
+
+  img->mem->info.width = img->metadata.width;
+  img->mem->info.height = img->metadata.height;
+  img->mem->info.depth = 1;
+  img->mem->copy_to_device();
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -688,7 +774,8 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
   const int texture_limit = scene->params.texture_limit;
 
   load_image_metadata(img);
-  ImageDataType type = img->metadata.type;
+  const bool use_cache = use_texture_cache(img);
+  ImageDataType type = use_cache ? IMAGE_DATA_TYPE_TEXTURE_CACHE : img->metadata.type;
 
   /* Name for debugging. */
   img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(type), (int)slot);
@@ -706,6 +793,13 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
   /* Create new texture. */
+  if (use_cache) {
+    device_load_image_texture_cache(img);
+    img->loader->cleanup();
+    img->need_load = false;
+    return;
+  }
+
   if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
       /* on failure to load, we set a 1x1 pixels pink image */
@@ -829,6 +923,10 @@ void ImageManager::device_free_image(Device *, size_t slot)
 #endif
   }
 
+  if (img->mem && img->mem->info.data_type == IMAGE_DATA_TYPE_TEXTURE_CACHE) {
+    ((TextureSystem *)texture_cache)->invalidate(img->loader->osl_filepath());
+  }
+
   if (img->mem) {
     thread_scoped_lock device_lock(device_mutex);
     delete img->mem;
@@ -851,6 +949,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  texture_cache_init(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -920,6 +1020,8 @@ void ImageManager::device_free(Device *device)
     device_free_image(device, slot);
   }
   images.clear();
+
+  texture_cache_free();
 }
 
 void ImageManager::collect_statistics(RenderStats *stats)
@@ -224,11 +224,19 @@ class ImageManager {
   vector<Image *> images;
   void *osl_texture_system;
 
+  /* OpenImageIO texture system for images read on demand in SVM, see use_texture_cache(). */
+  bool texture_cache_supported;
+  void *texture_cache;
+
   size_t add_image_slot(ImageLoader *loader, const ImageParams &params, const bool builtin);
   void add_image_user(size_t slot);
   void remove_image_user(size_t slot);
 
   void load_image_metadata(Image *img);
+  void texture_cache_init(Scene *scene);
+  void texture_cache_free();
+  bool use_texture_cache(const Image *img) const;
+  void device_load_image_texture_cache(Image *img);
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
@@ -805,20 +805,36 @@ void LightManager::device_update_tree(Device *,
   KernelIntegrator *kintegrator = &dscene->data.integrator;
 
   if (!kintegrator->use_light_tree) {
+    light_tree_.reset();
     return;
   }
 
   /* Update light tree. */
   progress.set_status("Updating Lights", "Computing tree");
 
-  /* TODO: For now, we'll start with a smaller number of max lights in a node.
-   * More benchmarking is needed to determine what number works best. */
-  LightTree light_tree(scene, dscene, progress, 8);
-  LightTreeNode *root = light_tree.build(scene, dscene);
-  if (progress.get_cancel()) {
-    return;
+  /* Refit the tree of the previous update if only lights and emissive objects were modified. This
+   * keeps the subtrees of emissive meshes, which are most of the work to build in scenes with many
+   * emissive triangles. */
+  const uint32_t refit_flags = LIGHT_MODIFIED | OBJECT_MANAGER | EMISSIVE_OBJECT_MODIFIED;
+  if (light_tree_ && (update_flags & ~refit_flags) == 0 && light_tree_->can_refit(scene) &&
+      light_tree_->refit(scene, dscene))
+  {
+    VLOG_INFO << "Refit light tree.";
+  }
+  else {
+    /* TODO: For now, we'll start with a smaller number of max lights in a node.
+     * More benchmarking is needed to determine what number works best. */
+    light_tree_ = make_unique<LightTree>(scene, dscene, progress, 8);
+    light_tree_->build(scene, dscene);
+    if (progress.get_cancel()) {
+      light_tree_.reset();
+      return;
+    }
   }
 
+  LightTree &light_tree = *light_tree_;
+  LightTreeNode *root = light_tree.get_root();
+
   /* Create arguments for recursive tree flatten. */
   LightTreeFlatten flatten;
   flatten.scene = scene;
@@ -899,6 +915,12 @@ void LightManager::device_update_tree(Device *,
   dscene->object_to_tree.copy_to_device();
   dscene->object_lookup_offset.copy_to_device();
   dscene->triangle_to_tree.copy_to_device();
+
+  /* Only keep the tree when a later update can refit it. A final render without persistent data
+   * does not update the scene again. */
+  if (scene->params.background && !scene->params.use_persistent_data) {
+    light_tree_.reset();
+  }
 }
 
 static void background_cdf(
@@ -1461,6 +1483,8 @@ void LightManager::device_update(Device *device,
 
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
+  light_tree_.reset();
+
   dscene->light_tree_nodes.free();
   dscene->light_tree_emitters.free();
   dscene->light_to_tree.free();
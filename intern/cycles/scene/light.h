@@ -16,12 +16,14 @@
 #include "util/ies.h"
 #include "util/thread.h"
 #include "util/types.h"
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
 class Device;
 class DeviceScene;
+class LightTree;
 class Progress;
 class Scene;
 class Shader;
@@ -107,6 +109,7 @@ class LightManager {
     OBJECT_MANAGER = (1 << 5),
     SHADER_COMPILED = (1 << 6),
     SHADER_MODIFIED = (1 << 7),
+    EMISSIVE_OBJECT_MODIFIED = (1 << 8),
 
     /* tag everything in the manager for an update */
     UPDATE_ALL = ~0u,
@@ -167,6 +170,11 @@ class LightManager {
   int last_background_resolution;
 
   uint32_t update_flags;
+
+  /* Light tree of the previous update, kept so that it can be refit when only the transforms and
+   * strengths of lights and emissive objects change. Not kept when the scene is not updated again
+   * after rendering. */
+  unique_ptr<LightTree> light_tree_;
 };
 
 CCL_NAMESPACE_END
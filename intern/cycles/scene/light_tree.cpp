@@ -7,6 +7,7 @@
 #include "scene/object.h"
 
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -265,12 +266,80 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, int prim_id)
 
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, int object_id)
 {
+  /* Find the emissive triangles first, so that the emitters can be created in parallel. */
+  vector<int> prim_ids;
   size_t mesh_num_triangles = mesh->num_triangles();
   for (size_t i = 0; i < mesh_num_triangles; i++) {
     if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+      prim_ids.push_back(i);
     }
   }
+
+  const size_t start = emitters_.size();
+  emitters_.resize(start + prim_ids.size());
+  parallel_for(blocked_range<size_t>(0, prim_ids.size(), MIN_EMITTERS_PER_THREAD),
+               [&](const blocked_range<size_t> &range) {
+                 for (size_t i = range.begin(); i != range.end(); i++) {
+                   emitters_[start + i] = LightTreeEmitter(scene, prim_ids[i], object_id);
+                 }
+               });
+}
+
+void LightTree::update_mesh_light_measure(Scene *scene,
+                                          LightTreeEmitter &emitter,
+                                          const LightTreeMeasure &mesh_measure)
+{
+  Object *object = scene->objects[emitter.object_id];
+  Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+
+  emitter.measure = mesh_measure;
+
+  /* Transform measure. The measure is only directly transformable if the transformation has
+   * uniform scaling, otherwise recount all the triangles in the mesh with transformation. */
+  /* NOTE: in theory only energy needs recalculating: #bbox is available via `object->bounds`,
+   * transformation of #bcone is possible. However, the computation involves eigendecomposition
+   * and solving a cubic equation (https://doi.org/10.1016/j.nima.2009.11.075 section 3.4), then
+   * the angle is derived from the major axis of the resulted right elliptic cone's base, which
+   * can be an overestimation. */
+  if (!mesh->transform_applied && !emitter.measure.transform(object->get_tfm())) {
+    emitter.measure.reset();
+    size_t mesh_num_triangles = mesh->num_triangles();
+    for (size_t i = 0; i < mesh_num_triangles; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        emitter.measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
+      }
+    }
+  }
+}
+
+vector<LightTree::EmitterKey> LightTree::collect_emitter_keys(Scene *scene)
+{
+  vector<EmitterKey> keys;
+
+  int scene_light_index = 0;
+  for (Light *light : scene->lights) {
+    if (light->is_enabled) {
+      const bool is_distant = light->light_type == LIGHT_BACKGROUND ||
+                              light->light_type == LIGHT_DISTANT;
+      keys.push_back(
+          {light, nullptr, scene_light_index, is_distant, light->get_light_set_membership()});
+    }
+    scene_light_index++;
+  }
+
+  int object_id = 0;
+  for (Object *object : scene->objects) {
+    if (object->usable_as_light()) {
+      keys.push_back({object,
+                      object->get_geometry(),
+                      object_id,
+                      false,
+                      object->get_light_set_membership()});
+    }
+    object_id++;
+  }
+
+  return keys;
 }
 
 LightTree::LightTree(Scene *scene,
@@ -304,6 +373,8 @@ LightTree::LightTree(Scene *scene,
     scene_light_index++;
   }
 
+  emitter_keys_ = collect_emitter_keys(scene);
+
   /* Similarly, we also want to keep track of the index of triangles of emissive objects. */
   int object_id = 0;
   for (Object *object : scene->objects) {
@@ -375,30 +446,17 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   });
   task_pool.wait_work();
 
+  /* Keep the measure of the meshes, the root of the subtree is replaced by the transformed
+   * measure of the first object using it. */
+  for (const auto &map_it : unique_mesh) {
+    mesh_measures_[map_it.first] = std::get<0>(map_it.second)->measure;
+  }
+
   /* Update measure. */
   parallel_for_each(mesh_lights_, [&](LightTreeEmitter &emitter) {
     Object *object = scene->objects[emitter.object_id];
     Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
-
-    LightTreeNode *reference = std::get<0>(unique_mesh.find(mesh)->second);
-    emitter.measure = emitter.root->measure = reference->measure;
-
-    /* Transform measure. The measure is only directly transformable if the transformation has
-     * uniform scaling, otherwise recount all the triangles in the mesh with transformation. */
-    /* NOTE: in theory only energy needs recalculating: #bbox is available via `object->bounds`,
-     * transformation of #bcone is possible. However, the computation involves eigendecomposition
-     * and solving a cubic equation (https://doi.org/10.1016/j.nima.2009.11.075 section 3.4), then
-     * the angle is derived from the major axis of the resulted right elliptic cone's base, which
-     * can be an overestimation. */
-    if (!mesh->transform_applied && !emitter.measure.transform(object->get_tfm())) {
-      emitter.measure.reset();
-      size_t mesh_num_triangles = mesh->num_triangles();
-      for (size_t i = 0; i < mesh_num_triangles; i++) {
-        if (triangle_usable_as_light(mesh, i)) {
-          emitter.measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
-        }
-      }
-    }
+    update_mesh_light_measure(scene, emitter, mesh_measures_.find(mesh)->second);
   });
 
   for (LightTreeEmitter &emitter : mesh_lights_) {
@@ -408,6 +466,7 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   /* Could be different from `num_triangles` if only some triangles of an object are emissive. */
   const int num_emissive_triangles = emitters_.size();
   num_local_lights += num_emissive_triangles;
+  num_emissive_triangles_ = num_emissive_triangles;
 
   /* Build the top level tree. */
   root_ = create_node(LightTreeMeasure::empty, 0);
@@ -445,9 +504,107 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
   std::move(distant_lights_.begin(), distant_lights_.end(), std::back_inserter(emitters_));
 
+  build_cost_ = top_level_cost();
+
   return root_.get();
 }
 
+bool LightTree::can_refit(Scene *scene) const
+{
+  if (!root_) {
+    return false;
+  }
+
+  /* Specialized trees for light linking keep state in the nodes of the mesh subtrees. */
+  for (Object *object : scene->objects) {
+    if (object->get_receiver_light_set()) {
+      return false;
+    }
+  }
+
+  return collect_emitter_keys(scene) == emitter_keys_;
+}
+
+/* Rebuild when the cost of the refit tree exceeds the cost after building it by this factor. */
+static const float LIGHT_TREE_MAX_REFIT_COST_RATIO = 1.5f;
+
+bool LightTree::refit(Scene *scene, DeviceScene *dscene)
+{
+  /* The emissive triangles at the start of the emitters did not change, only update the lights
+   * and objects after them. */
+  parallel_for(size_t(num_emissive_triangles_), emitters_.size(), [&](size_t i) {
+    LightTreeEmitter &emitter = emitters_[i];
+    if (emitter.is_mesh()) {
+      Object *object = scene->objects[emitter.object_id];
+      Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+      emitter.centroid = object->bounds.center();
+      update_mesh_light_measure(scene, emitter, mesh_measures_.find(mesh)->second);
+      emitter.root->measure = emitter.measure;
+    }
+    else {
+      const LightTreeEmitter light(scene, emitter.light_id, emitter.object_id);
+      emitter.centroid = light.centroid;
+      emitter.measure = light.measure;
+    }
+  });
+
+  uint *object_offsets = dscene->object_lookup_offset.alloc(scene->objects.size());
+  for (size_t i = num_emissive_triangles_; i < emitters_.size(); i++) {
+    const LightTreeEmitter &emitter = emitters_[i];
+    if (emitter.is_mesh()) {
+      Mesh *mesh = static_cast<Mesh *>(scene->objects[emitter.object_id]->get_geometry());
+      object_offsets[emitter.object_id] = offset_map_[mesh];
+    }
+  }
+
+  refit_node(root_.get());
+  root_->light_link.shareable = false;
+
+  const float cost = top_level_cost();
+  VLOG_WORK << "Light tree refit with cost " << cost << ", " << build_cost_ << " when built.";
+
+  return cost <= build_cost_ * LIGHT_TREE_MAX_REFIT_COST_RATIO;
+}
+
+void LightTree::refit_node(LightTreeNode *node)
+{
+  if (node->is_inner()) {
+    LightTreeNode *left_node = node->get_inner().children[left].get();
+    LightTreeNode *right_node = node->get_inner().children[right].get();
+    refit_node(left_node);
+    refit_node(right_node);
+    node->measure = left_node->measure + right_node->measure;
+    node->light_link = left_node->light_link + right_node->light_link;
+    return;
+  }
+
+  const LightTreeNode::Leaf &leaf = node->get_leaf();
+  node->measure = LightTreeMeasure::empty;
+  node->light_link = LightTreeLightLink();
+  for (int i = 0; i < leaf.num_emitters; i++) {
+    node->add(emitters_[leaf.first_emitter_index + i]);
+  }
+}
+
+static float light_tree_node_cost(const LightTreeNode *node)
+{
+  float cost = node->measure.calculate();
+  if (node->is_inner()) {
+    cost += light_tree_node_cost(node->get_inner().children[LightTree::left].get());
+    cost += light_tree_node_cost(node->get_inner().children[LightTree::right].get());
+  }
+  return cost;
+}
+
+float LightTree::top_level_cost() const
+{
+  const float root_cost = root_->measure.calculate();
+  if (root_cost == 0.0f) {
+    return 0.0f;
+  }
+  return light_tree_node_cost(root_.get()) / root_cost;
+}
+
 void LightTree::recursive_build(const Child child,
                                 LightTreeNode *inner,
                                 const int start,
@@ -510,6 +667,54 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+void LightTree::fill_buckets(
+    const LightTreeEmitter *emitters,
+    const int start,
+    const int end,
+    const int dim,
+    const BoundBox &centroid_bbox,
+    std::array<LightTreeBucket, LightTreeBucket::num_buckets> &buckets) const
+{
+  const float inv_extent = 1 / (centroid_bbox.size()[dim]);
+
+  auto fill = [&](const int fill_start,
+                  const int fill_end,
+                  std::array<LightTreeBucket, LightTreeBucket::num_buckets> &r_buckets) {
+    for (int i = fill_start; i < fill_end; i++) {
+      const LightTreeEmitter *emitter = emitters + i;
+
+      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
+       * partitions. */
+      int bucket_idx = LightTreeBucket::num_buckets *
+                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
+      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+
+      r_buckets[bucket_idx].add(*emitter);
+    }
+  };
+
+  const int num_chunks = divide_up(end - start, int(MIN_EMITTERS_PER_THREAD));
+  if (num_chunks <= 1) {
+    fill(start, end, buckets);
+    return;
+  }
+
+  /* The nodes near the root contain most emitters and are only split by a single thread, so bin
+   * their emitters in parallel. The chunks are merged in a fixed order, so that the result does
+   * not depend on the scheduling. */
+  vector<std::array<LightTreeBucket, LightTreeBucket::num_buckets>> chunk_buckets(num_chunks);
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * MIN_EMITTERS_PER_THREAD;
+    fill(chunk_start, min(chunk_start + int(MIN_EMITTERS_PER_THREAD), end), chunk_buckets[chunk]);
+  });
+
+  for (const std::array<LightTreeBucket, LightTreeBucket::num_buckets> &chunk : chunk_buckets) {
+    for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+      buckets[i] = buckets[i] + chunk[i];
+    }
+  }
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
                              int &middle,
@@ -552,17 +757,7 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
     /* Fill in buckets with emitters. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
-    }
+    fill_buckets(emitters, start, end, dim, centroid_bbox, buckets);
 
     /* Precompute the left bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> left_buckets;
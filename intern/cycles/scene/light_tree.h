@@ -13,6 +13,7 @@
 #include "util/types.h"
 #include "util/vector.h"
 
+#include <array>
 #include <variant>
 
 CCL_NAMESPACE_BEGIN
@@ -99,7 +100,7 @@ struct LightTreeMeasure {
   }
 
   /* Taken from Eq. 2 in the paper. */
-  __forceinline float calculate()
+  __forceinline float calculate() const
   {
     if (is_zero()) {
       return 0.0f;
@@ -191,6 +192,7 @@ struct LightTreeEmitter {
 
   LightTreeMeasure measure;
 
+  LightTreeEmitter() = default;
   LightTreeEmitter(Object *object, int object_id); /* Mesh emitter. */
   LightTreeEmitter(Scene *scene, int prim_id, int object_id, bool with_transformation = false);
 
@@ -386,6 +388,30 @@ class LightTree {
 
   std::unordered_map<Mesh *, int> offset_map_;
 
+  /* Measure of each unique emissive mesh in object space, before applying object transforms. */
+  std::unordered_map<Mesh *, LightTreeMeasure> mesh_measures_;
+
+  /* Lights and emissive objects the tree was built for, to check whether it can be refit. */
+  struct EmitterKey {
+    const Node *node;
+    const Geometry *geometry;
+    int index;
+    bool is_distant;
+    uint64_t light_set_membership;
+
+    bool operator==(const EmitterKey &other) const
+    {
+      return node == other.node && geometry == other.geometry && index == other.index &&
+             is_distant == other.is_distant && light_set_membership == other.light_set_membership;
+    }
+  };
+  vector<EmitterKey> emitter_keys_;
+
+  int num_emissive_triangles_ = 0;
+
+  /* Cost of the top level of the tree right after building it, see top_level_cost(). */
+  float build_cost_ = 0.0f;
+
   Progress &progress_;
 
   uint max_lights_in_leaf_;
@@ -409,6 +435,21 @@ class LightTree {
   /* Returns a pointer to the root node. */
   LightTreeNode *build(Scene *scene, DeviceScene *dscene);
 
+  /* Check whether the tree can be updated with refit() instead of being built again, which
+   * requires the same lights and emissive objects as when it was built. The caller is responsible
+   * for checking that the emissive meshes and shaders did not change. */
+  bool can_refit(Scene *scene) const;
+
+  /* Update the measures of the lights and emissive objects, and of the top level nodes above them.
+   * The structure of the tree and the subtrees of emissive meshes are kept.
+   * Returns false if the tree degraded too much compared to a new build. */
+  bool refit(Scene *scene, DeviceScene *dscene);
+
+  LightTreeNode *get_root() const
+  {
+    return root_.get();
+  }
+
   /* NOTE: Always use this function to create a new node so the number of nodes is in sync. */
   unique_ptr<LightTreeNode> create_node(const LightTreeMeasure &measure, const uint &bit_trial)
   {
@@ -440,6 +481,15 @@ class LightTree {
                        uint bit_trail,
                        int depth);
 
+  /* Add the emitters in the given range to the buckets along a dimension, in parallel for large
+   * ranges. */
+  void fill_buckets(const LightTreeEmitter *emitters,
+                    const int start,
+                    const int end,
+                    const int dim,
+                    const BoundBox &centroid_bbox,
+                    std::array<LightTreeBucket, LightTreeBucket::num_buckets> &buckets) const;
+
   bool should_split(LightTreeEmitter *emitters,
                     const int start,
                     int &middle,
@@ -453,6 +503,20 @@ class LightTree {
 
   /* Add all the emissive triangles of a mesh to the light tree. */
   void add_mesh(Scene *scene, Mesh *mesh, int object_id);
+
+  /* Compute the measure of an emissive object from the measure of its mesh. */
+  void update_mesh_light_measure(Scene *scene,
+                                 LightTreeEmitter &emitter,
+                                 const LightTreeMeasure &mesh_measure);
+
+  static vector<EmitterKey> collect_emitter_keys(Scene *scene);
+
+  /* Recompute the measures of a top level node and its children from the emitters. */
+  void refit_node(LightTreeNode *node);
+
+  /* Sum of the costs of all top level nodes relative to the cost of the root. This measures how
+   * well the nodes separate the emitters, independent of their total energy. */
+  float top_level_cost() const;
 };
 
 CCL_NAMESPACE_END
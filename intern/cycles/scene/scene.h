@@ -67,12 +67,26 @@ class SceneParams {
   bool use_bvh_spatial_split;
   bool use_bvh_compact_structure;
   bool use_bvh_unaligned_nodes;
+  /* Refit the BVHs of deforming geometry instead of rebuilding them, Embree only. */
+  bool use_bvh_refit;
   int num_bvh_time_steps;
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
 
+  /* Read image files on demand through a tiled and mipmapped cache, CPU and SVM only. */
+  bool use_texture_cache;
+  /* Memory budget of the texture cache in megabytes. */
+  int texture_cache_size;
+
+  /* Store mesh attributes with reduced precision when the error of every value is below the
+   * tolerance, see #AttributeFlag. */
+  bool use_attribute_quantization;
+  float attribute_quantization_tolerance;
+
   bool background;
+  /* Scene data is kept after rendering, to be updated for the next render. */
+  bool use_persistent_data;
 
   SceneParams()
   {
@@ -82,11 +96,17 @@ class SceneParams {
     use_bvh_spatial_split = false;
     use_bvh_compact_structure = true;
     use_bvh_unaligned_nodes = true;
+    use_bvh_refit = false;
     num_bvh_time_steps = 0;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    use_texture_cache = false;
+    texture_cache_size = 4096;
+    use_attribute_quantization = false;
+    attribute_quantization_tolerance = 1e-3f;
     background = true;
+    use_persistent_data = false;
   }
 
   bool modified(const SceneParams &params) const
@@ -96,9 +116,14 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_compact_structure == params.use_bvh_compact_structure &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
+             use_bvh_refit == params.use_bvh_refit &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             use_texture_cache == params.use_texture_cache &&
+             texture_cache_size == params.texture_cache_size &&
+             use_attribute_quantization == params.use_attribute_quantization &&
+             attribute_quantization_tolerance == params.attribute_quantization_tolerance);
   }
 
   int curve_subdivisions()
@@ -780,6 +780,56 @@ void ShaderGraph::compute_displacement_hash()
   displacement_hash = md5.get_hex();
 }
 
+void ShaderGraph::compute_structure_hash()
+{
+  /* Must be done before finalization, which modifies the graph. */
+  assert(!finalized);
+
+  MD5Hash md5;
+  foreach (ShaderNode *node, nodes) {
+    node->hash(md5);
+    md5.append((uint8_t *)&node->id, sizeof(node->id));
+    md5.append((uint8_t *)&node->bump, sizeof(node->bump));
+    foreach (ShaderInput *input, node->inputs) {
+      int link_id = (input->link) ? input->link->parent->id : -1;
+      md5.append((uint8_t *)&link_id, sizeof(link_id));
+      md5.append((input->link) ? input->link->name().c_str() : "");
+    }
+
+    if (node->special_type == SHADER_SPECIAL_TYPE_OSL) {
+      OSLNode *oslnode = static_cast<OSLNode *>(node);
+      md5.append(oslnode->bytecode_hash);
+    }
+
+    /* Images of the host application are not described by the sockets, only by their slots. */
+    const ImageHandle *handle = nullptr;
+    if (node->special_type == SHADER_SPECIAL_TYPE_IMAGE_SLOT) {
+      handle = &static_cast<ImageSlotTextureNode *>(node)->handle;
+    }
+    else if (node->type == PointDensityTextureNode::get_node_type()) {
+      handle = &static_cast<PointDensityTextureNode *>(node)->handle;
+    }
+    if (handle) {
+      for (int i = 0; i < handle->num_tiles(); i++) {
+        const int slot = handle->svm_slot(i);
+        md5.append((uint8_t *)&slot, sizeof(slot));
+      }
+    }
+
+    /* UDIM tiles are culled depending on the geometry that uses the graph, so the compiled shader
+     * can't be shared with other graphs. */
+    if (node->type == ImageTextureNode::get_node_type()) {
+      ImageTextureNode *image_node = static_cast<ImageTextureNode *>(node);
+      if (image_node->handle.empty() && image_node->get_tiles().size() > 1) {
+        structure_hash = "";
+        return;
+      }
+    }
+  }
+
+  structure_hash = md5.get_hex();
+}
+
 void ShaderGraph::clean(Scene *scene)
 {
   /* Graph simplification */
@@ -298,6 +298,9 @@ class ShaderGraph : public NodeOwner {
   bool finalized;
   bool simplified;
   string displacement_hash;
+  /* Hash of all nodes, their settings and links before finalization. Shaders with equal hashes
+   * compile to the same SVM nodes. Empty if not computed yet or if the graph can't be shared. */
+  string structure_hash;
 
   ShaderGraph();
   ~ShaderGraph();
@@ -314,6 +317,7 @@ class ShaderGraph : public NodeOwner {
 
   void remove_proxy_nodes();
   void compute_displacement_hash();
+  void compute_structure_hash();
   void simplify(Scene *scene);
   void finalize(Scene *scene, bool do_bump = false, bool bump_in_object_space = false);
 
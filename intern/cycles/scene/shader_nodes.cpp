@@ -393,6 +393,17 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
       flags |= NODE_IMAGE_ALPHA_UNASSOCIATE;
     }
   }
+  if (projection == NODE_IMAGE_PROJ_FLAT && tex_mapping.skip() && vector_in->link &&
+      vector_in->link->parent->type == TextureCoordinateNode::get_node_type() &&
+      vector_in->link->name() == "UV")
+  {
+    /* Unconnected vector inputs are linked to the UV output of a texture coordinate node too. */
+    const TextureCoordinateNode *texco = static_cast<const TextureCoordinateNode *>(
+        vector_in->link->parent);
+    if (!texco->get_from_dupli()) {
+      flags |= NODE_IMAGE_DEFAULT_UV;
+    }
+  }
 
   if (projection != NODE_IMAGE_PROJ_BOX) {
     /* If there only is one image (a very common case), we encode it as a negative value. */
@@ -16,8 +16,10 @@
 
 #include "util/foreach.h"
 #include "util/log.h"
+#include "util/md5.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -32,21 +34,58 @@ void SVMShaderManager::reset(Scene * /*scene*/) {}
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress *progress,
-                                            array<int4> *svm_nodes)
+                                            array<int4> *svm_nodes,
+                                            SVMCompiler::Summary *summary)
 {
   if (progress->get_cancel()) {
     return;
   }
   assert(shader->graph);
 
-  SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
-  compiler.compile(shader, *svm_nodes, 0, &summary);
+  compiler.compile(shader, *svm_nodes, 0, summary);
 
   VLOG_WORK << "Compilation summary:\n"
             << "Shader name: " << shader->name << "\n"
-            << summary.full_report();
+            << summary->full_report();
+}
+
+/* Key of the shader settings and graph that determine the compiled SVM nodes, or an empty string
+ * if the shader must be compiled by itself. */
+static string shader_compile_key(Scene *scene, Shader *shader)
+{
+  if (shader->graph->structure_hash.empty() ||
+      shader == scene->background->get_shader(scene))
+  {
+    return "";
+  }
+
+  return string_printf("%s %d %d %d",
+                       shader->graph->structure_hash.c_str(),
+                       (int)shader->get_displacement_method(),
+                       (int)shader->get_emission_sampling_method(),
+                       (int)(shader->reference_count() != 0));
+}
+
+/* Copy the information gathered while compiling from a shader with the same compile key. */
+static void shader_copy_compile_info(const Shader *from, Shader *to)
+{
+  to->has_surface = from->has_surface;
+  to->has_surface_transparent = from->has_surface_transparent;
+  to->has_surface_raytrace = from->has_surface_raytrace;
+  to->has_volume = from->has_volume;
+  to->has_displacement = from->has_displacement;
+  to->has_surface_bssrdf = from->has_surface_bssrdf;
+  to->has_bump = from->has_bump;
+  to->has_bssrdf_bump = from->has_bssrdf_bump;
+  to->has_surface_spatial_varying = from->has_surface_spatial_varying;
+  to->has_volume_spatial_varying = from->has_volume_spatial_varying;
+  to->has_volume_attribute_dependency = from->has_volume_attribute_dependency;
+
+  to->emission_estimate = from->emission_estimate;
+  to->emission_sampling = from->emission_sampling;
+  to->emission_is_constant = from->emission_is_constant;
 }
 
 void SVMShaderManager::device_update_specific(Device *device,
@@ -73,16 +112,38 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
+  /* Hash the graphs that were not compiled yet. Shaders with identical graphs and settings, as
+   * is common with many copies of the same material, are only compiled once. */
+  parallel_for(0, num_shaders, [scene](const int i) {
+    ShaderGraph *graph = scene->shaders[i]->graph;
+    if (graph->structure_hash.empty() && !graph->finalized) {
+      graph->compute_structure_hash();
+    }
+  });
+
+  /* Index of the shader whose SVM nodes are used for each shader. */
+  vector<int> shader_source(num_shaders);
+  unordered_map<string, int> compile_keys;
+  for (int i = 0; i < num_shaders; i++) {
+    const string key = shader_compile_key(scene, scene->shaders[i]);
+    shader_source[i] = (key.empty()) ? i : compile_keys.insert({key, i}).first->second;
+  }
+
   /* Build all shaders. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
+  vector<SVMCompiler::Summary> shader_summaries(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
+    if (shader_source[i] != i) {
+      continue;
+    }
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
                                  scene->shaders[i],
                                  &progress,
-                                 &shader_svm_nodes[i]));
+                                 &shader_svm_nodes[i],
+                                 &shader_summaries[i]));
   }
   task_pool.wait_work();
 
@@ -90,19 +151,61 @@ void SVMShaderManager::device_update_specific(Device *device,
     return;
   }
 
+  /* Different graphs may still compile to the same nodes after graph optimization, share the
+   * nodes of those too. */
+  unordered_map<string, int> compiled_nodes;
+  double time_finalize = 0.0;
+  double time_generate = 0.0;
+  int num_compiled = 0;
+  for (int i = 0; i < num_shaders; i++) {
+    if (shader_source[i] != i) {
+      shader_copy_compile_info(scene->shaders[shader_source[i]], scene->shaders[i]);
+      shader_source[i] = shader_source[shader_source[i]];
+      continue;
+    }
+
+    const SVMCompiler::Summary &summary = shader_summaries[i];
+    time_finalize += summary.time_finalize;
+    time_generate += summary.time_generate_surface + summary.time_generate_bump +
+                     summary.time_generate_volume + summary.time_generate_displacement;
+    num_compiled++;
+
+    MD5Hash md5;
+    md5.append((const uint8_t *)shader_svm_nodes[i].data(),
+               sizeof(int4) * shader_svm_nodes[i].size());
+    const auto [it, inserted] = compiled_nodes.insert({md5.get_hex(), i});
+    if (!inserted && shader_svm_nodes[it->second] == shader_svm_nodes[i]) {
+      shader_source[i] = it->second;
+    }
+  }
+
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    if (shader_source[i] == i) {
+      /* Since we're not copying the local jump node, the size ends up being one node lower. */
+      svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    }
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
 
+  /* Offset of the nodes of each shader in the global node list. */
+  vector<int> shader_node_offset(num_shaders);
   int node_offset = num_shaders;
+  for (int i = 0; i < num_shaders; i++) {
+    if (shader_source[i] == i) {
+      shader_node_offset[i] = node_offset;
+      node_offset += shader_svm_nodes[i].size() - 1;
+    }
+  }
+
+  int num_shared = 0;
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
+    const int source = shader_source[i];
+    num_shared += (source != i);
 
     shader->clear_modified();
     if (shader->emission_sampling != EMISSION_SAMPLING_NONE) {
@@ -113,25 +216,34 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int4 &local_jump_node = shader_svm_nodes[source][0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
-    global_jump_node.y = local_jump_node.y - 1 + node_offset;
-    global_jump_node.z = local_jump_node.z - 1 + node_offset;
-    global_jump_node.w = local_jump_node.w - 1 + node_offset;
-
-    node_offset += shader_svm_nodes[i].size() - 1;
+    global_jump_node.y = local_jump_node.y - 1 + shader_node_offset[source];
+    global_jump_node.z = local_jump_node.z - 1 + shader_node_offset[source];
+    global_jump_node.w = local_jump_node.w - 1 + shader_node_offset[source];
   }
 
   /* Copy the nodes of each shader into the correct location. */
-  svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
+    if (shader_source[i] == i) {
+      const int shader_size = shader_svm_nodes[i].size() - 1;
+      memcpy(svm_nodes + shader_node_offset[i],
+             &shader_svm_nodes[i][1],
+             sizeof(int4) * shader_size);
+    }
+  }
 
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
-    svm_nodes += shader_size;
+  if (scene->update_stats) {
+    scene->update_stats->svm.times.add_entry({"graph_finalize", time_finalize});
+    scene->update_stats->svm.times.add_entry({"svm_generate", time_generate});
   }
 
+  VLOG_INFO << "Compiled " << num_compiled << " shaders, " << num_shared
+            << " shaders share SVM nodes with other shaders. Time summed over threads: "
+            << time_finalize << " seconds graph finalization, " << time_generate
+            << " seconds SVM generation.";
+
   if (progress.get_cancel()) {
     return;
   }
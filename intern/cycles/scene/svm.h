@@ -25,28 +25,6 @@ class ShaderInput;
 class ShaderNode;
 class ShaderOutput;
 
-/* Shader Manager */
-
-class SVMShaderManager : public ShaderManager {
- public:
-  SVMShaderManager();
-  ~SVMShaderManager();
-
-  void reset(Scene *scene) override;
-
-  void device_update_specific(Device *device,
-                              DeviceScene *dscene,
-                              Scene *scene,
-                              Progress &progress) override;
-  void device_free(Device *device, DeviceScene *dscene, Scene *scene) override;
-
- protected:
-  void device_update_shader(Scene *scene,
-                            Shader *shader,
-                            Progress *progress,
-                            array<int4> *svm_nodes);
-};
-
 /* Graph Compiler */
 
 class SVMCompiler {
@@ -231,6 +209,29 @@ class SVMCompiler {
   bool compile_failed;
 };
 
+/* Shader Manager */
+
+class SVMShaderManager : public ShaderManager {
+ public:
+  SVMShaderManager();
+  ~SVMShaderManager();
+
+  void reset(Scene *scene) override;
+
+  void device_update_specific(Device *device,
+                              DeviceScene *dscene,
+                              Scene *scene,
+                              Progress &progress) override;
+  void device_free(Device *device, DeviceScene *dscene, Scene *scene) override;
+
+ protected:
+  void device_update_shader(Scene *scene,
+                            Shader *shader,
+                            Progress *progress,
+                            array<int4> *svm_nodes,
+                            SVMCompiler::Summary *summary);
+};
+
 CCL_NAMESPACE_END
 
 #endif /* __SVM_H__ */
@@ -761,13 +761,28 @@ void Session::collect_statistics(RenderStats *render_stats)
   }
 }
 
+RenderScheduler::WorkTimes Session::get_render_work_times() const
+{
+  return render_scheduler_.get_work_times();
+}
+
+int Session::get_num_rendered_samples() const
+{
+  return render_scheduler_.get_num_rendered_samples();
+}
+
 /* --------------------------------------------------------------------
  * Full-frame on-disk storage.
  */
 
 void Session::process_full_buffer_from_disk(string_view filename)
 {
-  path_trace_->process_full_buffer_from_disk(filename);
+  if (params.use_tile_streaming) {
+    path_trace_->process_full_buffer_tiles_from_disk(filename);
+  }
+  else {
+    path_trace_->process_full_buffer_from_disk(filename);
+  }
 }
 
 CCL_NAMESPACE_END
@@ -59,6 +59,10 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Denoise and write the full frame of tiled renders in tiles read from disk one at a time,
+   * instead of reading the full frame into memory. Requires the output driver to accept tiles. */
+  bool use_tile_streaming;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -82,6 +86,7 @@ class SessionParams {
 
     use_auto_tile = true;
     tile_size = 2048;
+    use_tile_streaming = false;
 
     use_resolution_divider = true;
 
@@ -154,6 +159,12 @@ class Session {
 
   void collect_statistics(RenderStats *stats);
 
+  /* Wall times of the rendering work, only meaningful when the session is not rendering. */
+  RenderScheduler::WorkTimes get_render_work_times() const;
+
+  /* Number of samples rendered since the last reset. */
+  int get_num_rendered_samples() const;
+
   /* --------------------------------------------------------------------
    * Full-frame on-disk storage.
    */
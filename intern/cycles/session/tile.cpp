@@ -662,4 +662,128 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   return true;
 }
 
+bool TileManager::open_full_buffer_from_disk(const string_view filename,
+                                             BufferParams *buffer_params,
+                                             DenoiseParams *denoise_params)
+{
+  close_full_buffer_from_disk();
+
+  unique_ptr<ImageInput> in(ImageInput::open(filename));
+  if (!in) {
+    LOG(ERROR) << "Error opening tile file " << filename;
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+
+  /* Regions can only be read in whole tiles of the image file. */
+  if (image_spec.tile_width == 0 || image_spec.tile_height == 0) {
+    LOG(ERROR) << "Tile file " << filename << " is not tiled.";
+    return false;
+  }
+
+  BufferParams full_buffer_params;
+  if (!buffer_params_from_image_spec_atttributes(&full_buffer_params, image_spec)) {
+    return false;
+  }
+
+  if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+    return false;
+  }
+
+  const int2 image_tile_size = make_int2(image_spec.tile_width, image_spec.tile_height);
+
+  read_state_.tile_size = make_int2(align_up(FULL_BUFFER_TILE_SIZE, image_tile_size.x),
+                                    align_up(FULL_BUFFER_TILE_SIZE, image_tile_size.y));
+  read_state_.overlap = make_int2(align_up(FULL_BUFFER_TILE_OVERLAP, image_tile_size.x),
+                                  align_up(FULL_BUFFER_TILE_OVERLAP, image_tile_size.y));
+
+  read_state_.num_tiles_x = divide_up(full_buffer_params.width, read_state_.tile_size.x);
+  read_state_.num_tiles_y = divide_up(full_buffer_params.height, read_state_.tile_size.y);
+
+  read_state_.buffer_params = full_buffer_params;
+  read_state_.tile_in = std::move(in);
+
+  *buffer_params = std::move(full_buffer_params);
+
+  VLOG_WORK << "Reading tile file " << filename << " in " << get_num_full_buffer_tiles()
+            << " tiles of size " << read_state_.tile_size;
+
+  return true;
+}
+
+void TileManager::close_full_buffer_from_disk()
+{
+  if (!read_state_.tile_in) {
+    return;
+  }
+
+  if (!read_state_.tile_in->close()) {
+    LOG(ERROR) << "Error closing tile file " << read_state_.tile_in->geterror();
+  }
+
+  read_state_.tile_in = nullptr;
+  read_state_.num_tiles_x = 0;
+  read_state_.num_tiles_y = 0;
+}
+
+bool TileManager::read_full_buffer_tile_from_disk(const int tile_index, RenderBuffers *buffers)
+{
+  DCHECK(read_state_.tile_in);
+  DCHECK_LT(tile_index, get_num_full_buffer_tiles());
+
+  const BufferParams &full_params = read_state_.buffer_params;
+  const int2 tile_size = read_state_.tile_size;
+  const int2 overlap = read_state_.overlap;
+
+  const int tile_index_y = tile_index / read_state_.num_tiles_x;
+  const int tile_index_x = tile_index - tile_index_y * read_state_.num_tiles_x;
+
+  const int window_x = tile_index_x * tile_size.x;
+  const int window_y = tile_index_y * tile_size.y;
+  const int window_width = min(tile_size.x, full_params.width - window_x);
+  const int window_height = min(tile_size.y, full_params.height - window_y);
+
+  /* The overlap is aligned to the image tiles, so the region boundaries are either on an image
+   * tile boundary or on the image border, as required by read_tiles(). */
+  const int x_begin = max(0, window_x - overlap.x);
+  const int y_begin = max(0, window_y - overlap.y);
+  const int x_end = min(full_params.width, window_x + window_width + overlap.x);
+  const int y_end = min(full_params.height, window_y + window_height + overlap.y);
+
+  BufferParams params = full_params;
+  params.width = x_end - x_begin;
+  params.height = y_end - y_begin;
+  params.window_x = window_x - x_begin;
+  params.window_y = window_y - y_begin;
+  params.window_width = window_width;
+  params.window_height = window_height;
+  params.full_x += x_begin;
+  params.full_y += y_begin;
+  params.update_offset_stride();
+
+  buffers->reset(params);
+
+  ImageInput *in = read_state_.tile_in.get();
+  const int num_channels = in->spec().nchannels;
+  if (!in->read_tiles(0,
+                      0,
+                      x_begin,
+                      x_end,
+                      y_begin,
+                      y_end,
+                      0,
+                      1,
+                      0,
+                      num_channels,
+                      TypeDesc::FLOAT,
+                      buffers->buffer.data()))
+  {
+    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
+    return false;
+  }
+
+  return true;
+}
+
 CCL_NAMESPACE_END
@@ -104,6 +104,26 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Read full frame render buffer from tiles file on disk in parts, without ever keeping the full
+   * frame in memory.
+   *
+   * The frame is split into tiles of FULL_BUFFER_TILE_SIZE which are read with an overlap of
+   * FULL_BUFFER_TILE_OVERLAP pixels on each side, so that the denoiser has enough context at the
+   * tile borders. The window of the read buffers covers the tile without the overlap.
+   *
+   * Returns true on success. */
+  bool open_full_buffer_from_disk(string_view filename,
+                                  BufferParams *buffer_params,
+                                  DenoiseParams *denoise_params);
+  void close_full_buffer_from_disk();
+
+  inline int get_num_full_buffer_tiles() const
+  {
+    return read_state_.num_tiles_x * read_state_.num_tiles_y;
+  }
+
+  bool read_full_buffer_tile_from_disk(int tile_index, RenderBuffers *buffers);
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -116,6 +136,11 @@ class TileManager {
    * Use conservative value which is safe for most of OpenGL drivers and GPUs. */
   static const int MAX_TILE_SIZE = 8192;
 
+  /* Size of the tiles and their overlap when reading the full frame from disk in parts.
+   * Both are aligned up to the tile size in the image file. */
+  static const int FULL_BUFFER_TILE_SIZE = 1024;
+  static const int FULL_BUFFER_TILE_OVERLAP = 64;
+
  protected:
   /* Get tile configuration for its index.
    * The tile index must be within [0, state_.tile_state_). */
@@ -173,6 +198,20 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* State of reading tiles of the full frame from a file on disk. */
+  struct {
+    unique_ptr<ImageInput> tile_in;
+
+    /* Parameters of the full frame buffer stored in the file. */
+    BufferParams buffer_params;
+
+    int2 tile_size = make_int2(0, 0);
+    int2 overlap = make_int2(0, 0);
+
+    int num_tiles_x = 0;
+    int num_tiles_y = 0;
+  } read_state_;
 };
 
 CCL_NAMESPACE_END
@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "util/json.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(util_json, writer)
+{
+  JSONWriter writer;
+  writer.begin_object();
+  writer.key("name");
+  writer.value("a \"quoted\"\\path\n\x01");
+  writer.key("values");
+  writer.begin_array();
+  writer.value(1.5);
+  writer.value(2);
+  writer.value(true);
+  writer.value(1.0 / 0.0);
+  writer.end_array();
+  writer.key("empty");
+  writer.begin_object();
+  writer.end_object();
+  writer.end_object();
+
+  EXPECT_EQ(writer.get_string(),
+            "{\n"
+            "  \"name\": \"a \\\"quoted\\\"\\\\path\\n\\u0001\",\n"
+            "  \"values\": [\n"
+            "    1.5,\n"
+            "    2,\n"
+            "    true,\n"
+            "    null\n"
+            "  ],\n"
+            "  \"empty\": {}\n"
+            "}\n");
+}
+
+TEST(util_json, reader)
+{
+  const string text =
+      "{\"skip\": [1, {\"a\": null}, false, \"x\"], \"s\": \"\\\"\\\\\\/\\t\\u00e9\\ud83d\\ude00\","
+      " \"n\": -1.5e3, \"list\": [1, 2, 3]}";
+  JSONReader reader(text);
+
+  string str;
+  double number = 0.0;
+  vector<double> list;
+  const bool success = reader.read_object([&](const string &key) {
+    if (key == "s") {
+      return reader.read_string(str);
+    }
+    if (key == "n") {
+      return reader.read_number(number);
+    }
+    if (key == "list") {
+      return reader.read_array([&]() {
+        double value;
+        if (!reader.read_number(value)) {
+          return false;
+        }
+        list.push_back(value);
+        return true;
+      });
+    }
+    return reader.skip_value();
+  });
+
+  EXPECT_TRUE(success);
+  EXPECT_TRUE(reader.at_end());
+  EXPECT_EQ(str, "\"\\/\t\xc3\xa9\xf0\x9f\x98\x80");
+  EXPECT_EQ(number, -1500.0);
+  EXPECT_EQ(list, vector<double>({1.0, 2.0, 3.0}));
+}
+
+TEST(util_json, round_trip)
+{
+  const string value = "line\nbreak \"quote\" \\ tab\t control\x1f utf8 \xc3\xa9";
+
+  JSONWriter writer;
+  writer.begin_object();
+  writer.key(value);
+  writer.value(value);
+  writer.end_object();
+
+  JSONReader reader(writer.get_string());
+  string key, str;
+  EXPECT_TRUE(reader.read_object([&](const string &member) {
+    key = member;
+    return reader.read_string(str);
+  }));
+  EXPECT_EQ(key, value);
+  EXPECT_EQ(str, value);
+}
+
+TEST(util_json, reader_errors)
+{
+  double number;
+  EXPECT_FALSE(JSONReader("null").read_number(number));
+  EXPECT_FALSE(JSONReader("{\"a\" 1}").skip_value());
+  EXPECT_FALSE(JSONReader("[1, 2").skip_value());
+  EXPECT_FALSE(JSONReader("\"unterminated").skip_value());
+  EXPECT_FALSE(JSONReader("\"\\x\"").skip_value());
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,165 @@
+/* SPDX-FileCopyrightText: 2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "scene/attribute.h"
+
+#include "util/math.h"
+#include "util/quantize.h"
+
+CCL_NAMESPACE_BEGIN
+
+static float round_trip_half(const float f)
+{
+  return half_bits_to_float(float_to_half_bits(f));
+}
+
+static float round_trip_norm(const float f, const bool is_8bit, const bool is_signed)
+{
+  return norm_to_float(float_to_norm(f, is_8bit, is_signed), is_8bit, is_signed);
+}
+
+static float3 round_trip_octahedral(const float3 n)
+{
+  return octahedral_to_float3(float3_to_octahedral(n));
+}
+
+TEST(util_quantize, half)
+{
+  EXPECT_EQ(float_to_half_bits(0.0f), 0);
+  EXPECT_EQ(float_to_half_bits(1.0f), 0x3c00);
+  EXPECT_EQ(float_to_half_bits(-2.0f), 0xc000);
+
+  /* Zero and values that are representable as half float are decoded exactly. */
+  EXPECT_EQ(round_trip_half(0.0f), 0.0f);
+  EXPECT_EQ(round_trip_half(1.0f), 1.0f);
+  EXPECT_EQ(round_trip_half(-2.5f), -2.5f);
+  EXPECT_EQ(round_trip_half(65504.0f), 65504.0f);
+
+  /* Rounding to nearest keeps the relative error within half of the 10 bit mantissa step. */
+  EXPECT_NEAR(round_trip_half(0.1f), 0.1f, 0.1f / 2048.0f);
+  EXPECT_NEAR(round_trip_half(-1234.567f), -1234.567f, 1234.567f / 2048.0f);
+
+  /* Values outside of the half float range are clamped, tiny values and NaN become zero. */
+  EXPECT_EQ(round_trip_half(65520.0f), 65504.0f);
+  EXPECT_EQ(round_trip_half(1e10f), 65504.0f);
+  EXPECT_EQ(round_trip_half(-1e10f), -65504.0f);
+  EXPECT_EQ(round_trip_half(1e-6f), 0.0f);
+  EXPECT_EQ(round_trip_half(NAN), 0.0f);
+}
+
+TEST(util_quantize, unorm)
+{
+  for (const bool is_8bit : {true, false}) {
+    const uint max_value = is_8bit ? 0xff : 0xffff;
+    EXPECT_EQ(float_to_norm(0.0f, is_8bit, false), 0);
+    EXPECT_EQ(float_to_norm(1.0f, is_8bit, false), max_value);
+
+    /* Values outside of [0, 1] are clamped. */
+    EXPECT_EQ(float_to_norm(-1.0f, is_8bit, false), 0);
+    EXPECT_EQ(float_to_norm(2.0f, is_8bit, false), max_value);
+
+    EXPECT_EQ(round_trip_norm(0.0f, is_8bit, false), 0.0f);
+    EXPECT_EQ(round_trip_norm(1.0f, is_8bit, false), 1.0f);
+    /* Within half a step, up to float precision. */
+    for (const float f : {0.1234f, 0.5f, 0.9f}) {
+      EXPECT_NEAR(round_trip_norm(f, is_8bit, false), f, 0.5f / max_value + 1e-6f);
+    }
+  }
+}
+
+TEST(util_quantize, snorm)
+{
+  for (const bool is_8bit : {true, false}) {
+    const uint max_value = is_8bit ? 0x7f : 0x7fff;
+    /* All values fit in the number of bits of the encoding. */
+    EXPECT_EQ(float_to_norm(-1.0f, is_8bit, true), 0);
+    EXPECT_EQ(float_to_norm(1.0f, is_8bit, true), max_value * 2);
+    EXPECT_EQ(float_to_norm(-2.0f, is_8bit, true), 0);
+    EXPECT_EQ(float_to_norm(2.0f, is_8bit, true), max_value * 2);
+
+    EXPECT_EQ(round_trip_norm(0.0f, is_8bit, true), 0.0f);
+    EXPECT_EQ(round_trip_norm(1.0f, is_8bit, true), 1.0f);
+    EXPECT_EQ(round_trip_norm(-1.0f, is_8bit, true), -1.0f);
+    for (const float f : {-0.9f, -0.1234f, 0.1234f, 0.5f}) {
+      EXPECT_NEAR(round_trip_norm(f, is_8bit, true), f, 0.5f / max_value + 1e-6f);
+    }
+  }
+}
+
+TEST(util_quantize, octahedral)
+{
+  /* Axes are decoded exactly, on both hemispheres. */
+  for (const float3 n : {make_float3(1.0f, 0.0f, 0.0f),
+                         make_float3(0.0f, -1.0f, 0.0f),
+                         make_float3(0.0f, 0.0f, 1.0f),
+                         make_float3(0.0f, 0.0f, -1.0f)})
+  {
+    const float3 result = round_trip_octahedral(n);
+    EXPECT_EQ(result.x, n.x);
+    EXPECT_EQ(result.y, n.y);
+    EXPECT_EQ(result.z, n.z);
+  }
+
+  for (const float3 n : {normalize(make_float3(1.0f, 2.0f, 3.0f)),
+                         normalize(make_float3(-1.0f, 2.0f, -3.0f)),
+                         normalize(make_float3(-0.3f, -0.1f, -0.9f))})
+  {
+    const float3 result = round_trip_octahedral(n);
+    EXPECT_NEAR(result.x, n.x, 1e-4f);
+    EXPECT_NEAR(result.y, n.y, 1e-4f);
+    EXPECT_NEAR(result.z, n.z, 1e-4f);
+  }
+}
+
+static uint choose_float_quantization(const vector<float> &values, const float tolerance)
+{
+  Attribute attr(
+      ustring("test"), TypeDesc::TypeFloat, ATTR_ELEMENT_MESH, nullptr, ATTR_PRIM_GEOMETRY);
+  attr.resize(values.size());
+  std::copy(values.begin(), values.end(), attr.data_float());
+  return choose_attribute_quantization(attr, values.size(), tolerance);
+}
+
+static uint choose_float3_quantization(const vector<float3> &values, const float tolerance)
+{
+  Attribute attr(
+      ustring("test"), TypeDesc::TypeNormal, ATTR_ELEMENT_MESH, nullptr, ATTR_PRIM_GEOMETRY);
+  attr.resize(values.size());
+  std::copy(values.begin(), values.end(), attr.data_float3());
+  return choose_attribute_quantization(attr, values.size(), tolerance);
+}
+
+TEST(util_quantize, choose_attribute_quantization)
+{
+  /* The smallest normalized encoding within the tolerance. */
+  EXPECT_EQ(choose_float_quantization({0.0f, 0.1234f, 0.5f, 1.0f}, 1e-2f), ATTR_QUANTIZED_NORM8);
+  EXPECT_EQ(choose_float_quantization({0.0f, 0.1234f, 0.5f, 1.0f}, 1e-3f), ATTR_QUANTIZED_NORM16);
+  EXPECT_EQ(choose_float_quantization({-0.5f, 0.1234f, 1.0f}, 1e-2f),
+            ATTR_QUANTIZED_NORM8 | ATTR_QUANTIZED_SIGNED);
+  EXPECT_EQ(choose_float_quantization({-0.5f, 0.1234f, 1.0f}, 1e-3f),
+            ATTR_QUANTIZED_NORM16 | ATTR_QUANTIZED_SIGNED);
+
+  /* Half floats for values outside of [-1, 1] or when the normalized encodings are too coarse. */
+  EXPECT_EQ(choose_float_quantization({0.5f, 2.0f, -100.0f}, 1e-1f), ATTR_QUANTIZED_HALF);
+  EXPECT_EQ(choose_float_quantization({0.0f, 0.5f, 1.0f / 1024.0f}, 0.0f), ATTR_QUANTIZED_HALF);
+
+  /* No quantization when even half floats are not precise enough. */
+  EXPECT_EQ(choose_float_quantization({1000.1f}, 1e-3f), 0);
+  EXPECT_EQ(choose_float_quantization({1e6f}, 1.0f), 0);
+  EXPECT_EQ(choose_float_quantization({0.5f, NAN}, 1.0f), 0);
+
+  /* Unit vectors use the octahedral encoding, other vectors half floats. */
+  EXPECT_EQ(choose_float3_quantization({make_float3(1.0f, 0.0f, 0.0f),
+                                        make_float3(0.0f, 0.0f, -1.0f),
+                                        normalize(make_float3(1.0f, 2.0f, -3.0f))},
+                                       1e-3f),
+            ATTR_QUANTIZED_OCTAHEDRAL);
+  EXPECT_EQ(choose_float3_quantization({make_float3(2.0f, 0.0f, 0.5f)}, 1e-3f),
+            ATTR_QUANTIZED_HALF);
+  EXPECT_EQ(choose_float3_quantization({make_float3(1e6f, 0.0f, 0.0f)}, 1e-3f), 0);
+}
+
+CCL_NAMESPACE_END
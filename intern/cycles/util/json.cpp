@@ -0,0 +1,345 @@
+/* SPDX-FileCopyrightText: 2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "util/json.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+CCL_NAMESPACE_BEGIN
+
+/* Writer */
+
+void JSONWriter::begin_object()
+{
+  begin_value();
+  str_ += '{';
+  scopes_.push_back(false);
+}
+
+void JSONWriter::end_object()
+{
+  const bool has_values = scopes_.back();
+  scopes_.pop_back();
+  if (has_values) {
+    append_indent();
+  }
+  str_ += '}';
+  if (scopes_.empty()) {
+    str_ += '\n';
+  }
+}
+
+void JSONWriter::begin_array()
+{
+  begin_value();
+  str_ += '[';
+  scopes_.push_back(false);
+}
+
+void JSONWriter::end_array()
+{
+  const bool has_values = scopes_.back();
+  scopes_.pop_back();
+  if (has_values) {
+    append_indent();
+  }
+  str_ += ']';
+}
+
+void JSONWriter::key(const string &key)
+{
+  begin_value();
+  append_string(key);
+  str_ += ": ";
+  after_key_ = true;
+}
+
+void JSONWriter::value(const string &value)
+{
+  begin_value();
+  append_string(value);
+}
+
+void JSONWriter::value(const char *value)
+{
+  this->value(string(value));
+}
+
+void JSONWriter::value(const double value)
+{
+  begin_value();
+  str_ += (isfinite(value)) ? string_printf("%.9g", value) : "null";
+}
+
+void JSONWriter::value(const int value)
+{
+  begin_value();
+  str_ += string_printf("%d", value);
+}
+
+void JSONWriter::value(const bool value)
+{
+  begin_value();
+  str_ += (value) ? "true" : "false";
+}
+
+void JSONWriter::begin_value()
+{
+  /* The value of a member follows its key on the same line. */
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (scopes_.empty()) {
+    return;
+  }
+  if (scopes_.back()) {
+    str_ += ',';
+  }
+  scopes_.back() = true;
+  append_indent();
+}
+
+void JSONWriter::append_string(const string &str)
+{
+  str_ += '"';
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        str_ += "\\\"";
+        break;
+      case '\\':
+        str_ += "\\\\";
+        break;
+      case '\n':
+        str_ += "\\n";
+        break;
+      case '\r':
+        str_ += "\\r";
+        break;
+      case '\t':
+        str_ += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          str_ += string_printf("\\u%04x", (int)c);
+        }
+        else {
+          /* Other characters including UTF-8 sequences are written as is. */
+          str_ += c;
+        }
+        break;
+    }
+  }
+  str_ += '"';
+}
+
+void JSONWriter::append_indent()
+{
+  str_ += '\n';
+  str_.append(scopes_.size() * 2, ' ');
+}
+
+/* Reader */
+
+char JSONReader::peek()
+{
+  while (pos_ < text_.size() && isspace((unsigned char)text_[pos_])) {
+    pos_++;
+  }
+  return (pos_ < text_.size()) ? text_[pos_] : '\0';
+}
+
+bool JSONReader::at_end()
+{
+  return peek() == '\0';
+}
+
+bool JSONReader::consume(const char c)
+{
+  if (peek() != c) {
+    return false;
+  }
+  pos_++;
+  return true;
+}
+
+bool JSONReader::read_object(const function<bool(const string &key)> &read_member)
+{
+  if (!consume('{')) {
+    return false;
+  }
+  if (consume('}')) {
+    return true;
+  }
+  do {
+    string key;
+    if (!read_string(key) || !consume(':') || !read_member(key)) {
+      return false;
+    }
+  } while (consume(','));
+  return consume('}');
+}
+
+bool JSONReader::read_array(const function<bool()> &read_element)
+{
+  if (!consume('[')) {
+    return false;
+  }
+  if (consume(']')) {
+    return true;
+  }
+  do {
+    if (!read_element()) {
+      return false;
+    }
+  } while (consume(','));
+  return consume(']');
+}
+
+bool JSONReader::read_hex4(uint &r_code)
+{
+  if (pos_ + 4 > text_.size()) {
+    return false;
+  }
+  r_code = 0;
+  for (int i = 0; i < 4; i++) {
+    const char c = text_[pos_++];
+    if (!isxdigit((unsigned char)c)) {
+      return false;
+    }
+    r_code = r_code * 16 + (isdigit((unsigned char)c) ? c - '0' : tolower(c) - 'a' + 10);
+  }
+  return true;
+}
+
+static void append_utf8(string &r_str, const uint code)
+{
+  if (code < 0x80) {
+    r_str += (char)code;
+  }
+  else if (code < 0x800) {
+    r_str += (char)(0xC0 | (code >> 6));
+    r_str += (char)(0x80 | (code & 0x3F));
+  }
+  else if (code < 0x10000) {
+    r_str += (char)(0xE0 | (code >> 12));
+    r_str += (char)(0x80 | ((code >> 6) & 0x3F));
+    r_str += (char)(0x80 | (code & 0x3F));
+  }
+  else {
+    r_str += (char)(0xF0 | (code >> 18));
+    r_str += (char)(0x80 | ((code >> 12) & 0x3F));
+    r_str += (char)(0x80 | ((code >> 6) & 0x3F));
+    r_str += (char)(0x80 | (code & 0x3F));
+  }
+}
+
+bool JSONReader::read_string(string &r_str)
+{
+  if (!consume('"')) {
+    return false;
+  }
+  r_str.clear();
+  while (pos_ < text_.size()) {
+    const char c = text_[pos_++];
+    if (c == '"') {
+      return true;
+    }
+    if (c != '\\') {
+      r_str += c;
+      continue;
+    }
+    if (pos_ >= text_.size()) {
+      return false;
+    }
+    switch (text_[pos_++]) {
+      case '"':
+        r_str += '"';
+        break;
+      case '\\':
+        r_str += '\\';
+        break;
+      case '/':
+        r_str += '/';
+        break;
+      case 'b':
+        r_str += '\b';
+        break;
+      case 'f':
+        r_str += '\f';
+        break;
+      case 'n':
+        r_str += '\n';
+        break;
+      case 'r':
+        r_str += '\r';
+        break;
+      case 't':
+        r_str += '\t';
+        break;
+      case 'u': {
+        uint code;
+        if (!read_hex4(code)) {
+          return false;
+        }
+        /* Characters outside of the basic plane are written as a surrogate pair. */
+        if (code >= 0xD800 && code < 0xDC00 && text_.compare(pos_, 2, "\\u") == 0) {
+          pos_ += 2;
+          uint low;
+          if (!read_hex4(low) || low < 0xDC00 || low >= 0xE000) {
+            return false;
+          }
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        append_utf8(r_str, code);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+bool JSONReader::read_number(double &r_value)
+{
+  const char c = peek();
+  if (!(c == '-' || isdigit((unsigned char)c))) {
+    return false;
+  }
+  const char *start = text_.c_str() + pos_;
+  char *end;
+  r_value = strtod(start, &end);
+  pos_ += end - start;
+  return end != start;
+}
+
+bool JSONReader::skip_value()
+{
+  const char c = peek();
+  if (c == '{') {
+    return read_object([&](const string & /*key*/) { return skip_value(); });
+  }
+  if (c == '[') {
+    return read_array([&]() { return skip_value(); });
+  }
+  if (c == '"') {
+    string str;
+    return read_string(str);
+  }
+  for (const char *literal : {"true", "false", "null"}) {
+    if (text_.compare(pos_, strlen(literal), literal) == 0) {
+      pos_ += strlen(literal);
+      return true;
+    }
+  }
+  double value;
+  return read_number(value);
+}
+
+CCL_NAMESPACE_END
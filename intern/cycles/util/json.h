@@ -0,0 +1,81 @@
+/* SPDX-FileCopyrightText: 2024 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#ifndef __UTIL_JSON_H__
+#define __UTIL_JSON_H__
+
+#include "util/function.h"
+#include "util/string.h"
+#include "util/types.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Writer of indented JSON text. Values are written in document order, every value in an object
+ * has to be preceded by its key. */
+
+class JSONWriter {
+ public:
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  void key(const string &key);
+
+  void value(const string &value);
+  void value(const char *value);
+  /* Numbers that JSON can't represent, like infinity, are written as null. */
+  void value(double value);
+  void value(int value);
+  void value(bool value);
+
+  /* The text written so far, complete once all objects and arrays are ended. */
+  const string &get_string() const
+  {
+    return str_;
+  }
+
+ protected:
+  void begin_value();
+  void append_string(const string &str);
+  void append_indent();
+
+  string str_;
+  /* For every object and array that is not ended yet, whether it has any values yet. */
+  vector<bool> scopes_;
+  bool after_key_ = false;
+};
+
+/* Reader of JSON text, where the caller reads the values it expects and skips the others. All
+ * functions return false when the text doesn't contain what was asked for. */
+
+class JSONReader {
+ public:
+  explicit JSONReader(const string &text) : text_(text) {}
+
+  /* First character of the next value, or '\0' at the end of the text. */
+  char peek();
+  /* True if nothing but whitespace is left. */
+  bool at_end();
+
+  /* Read all members of an object, the callback has to read or skip the value of every member. */
+  bool read_object(const function<bool(const string &key)> &read_member);
+  /* Read all elements of an array, the callback has to read or skip every element. */
+  bool read_array(const function<bool()> &read_element);
+  bool read_string(string &r_str);
+  bool read_number(double &r_value);
+  bool skip_value();
+
+ protected:
+  bool consume(const char c);
+  bool read_hex4(uint &r_code);
+
+  string text_;
+  size_t pos_ = 0;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __UTIL_JSON_H__ */
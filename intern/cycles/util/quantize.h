@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+#include "util/math.h"
+#include "util/types.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Quantization
+ *
+ * Reduced precision encodings of attribute values. Values are encoded on the host and decoded in
+ * the kernel, so both sides have to use these functions to get identical results. All encodings
+ * produce 8 or 16 bits per component, packed into 32-bit words by the caller. */
+
+/* Half float bits with round to nearest. Unlike the conversion for image textures, zero is
+ * decoded exactly. Values below the smallest normal half float are flushed to zero, values above
+ * the largest half float are clamped. */
+ccl_device_inline uint float_to_half_bits(const float f)
+{
+  const uint sign = (__float_as_uint(f) >> 16) & 0x8000;
+  const float a = fabsf(f);
+  /* Also catches NaN. */
+  if (!(a >= 6.103515625e-05f)) {
+    return sign;
+  }
+  if (a >= 65504.0f) {
+    return sign | 0x7bff;
+  }
+  /* Round the mantissa and adjust the exponent bias. */
+  return sign | (((__float_as_uint(a) + 0x1000) >> 13) - 0x1c000);
+}
+
+ccl_device_inline float half_bits_to_float(const uint h)
+{
+  const uint magnitude = h & 0x7fff;
+  const uint bits = (magnitude != 0) ? (magnitude << 13) + 0x38000000 : 0;
+  return __uint_as_float(((h & 0x8000) << 16) | bits);
+}
+
+/* Normalized integers, for values in [0, 1] (unorm) or [-1, 1] (snorm). Signed values are stored
+ * with an offset rather than in two's complement, so they decode without sign extension. */
+ccl_device_inline uint float_to_unorm(const float f, const uint max_value)
+{
+  return (uint)(saturatef(f) * (float)max_value + 0.5f);
+}
+
+ccl_device_inline float unorm_to_float(const uint u, const uint max_value)
+{
+  return (float)u / (float)max_value;
+}
+
+ccl_device_inline uint float_to_snorm(const float f, const uint max_value)
+{
+  return (uint)(floorf(clamp(f, -1.0f, 1.0f) * (float)max_value + 0.5f) + (float)max_value);
+}
+
+ccl_device_inline float snorm_to_float(const uint u, const uint max_value)
+{
+  return (float)((int)u - (int)max_value) / (float)max_value;
+}
+
+/* Normalized integers with 8 or 16 bits, where signed values use one bit less for the magnitude.
+ * These match the ATTR_QUANTIZED_NORM8, ATTR_QUANTIZED_NORM16 and ATTR_QUANTIZED_SIGNED flags. */
+ccl_device_inline uint norm_max_value(const bool is_8bit, const bool is_signed)
+{
+  return (is_8bit ? 0xffu : 0xffffu) >> (is_signed ? 1 : 0);
+}
+
+ccl_device_inline uint float_to_norm(const float f, const bool is_8bit, const bool is_signed)
+{
+  const uint max_value = norm_max_value(is_8bit, is_signed);
+  return is_signed ? float_to_snorm(f, max_value) : float_to_unorm(f, max_value);
+}
+
+ccl_device_inline float norm_to_float(const uint u, const bool is_8bit, const bool is_signed)
+{
+  const uint max_value = norm_max_value(is_8bit, is_signed);
+  return is_signed ? snorm_to_float(u, max_value) : unorm_to_float(u, max_value);
+}
+
+/* Octahedral encoding of unit vectors with 16 bits per component. */
+ccl_device_inline uint float3_to_octahedral(const float3 n)
+{
+  const float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+  float x = (l1 > 0.0f) ? n.x / l1 : 0.0f;
+  float y = (l1 > 0.0f) ? n.y / l1 : 0.0f;
+  if (n.z < 0.0f) {
+    const float wrap_x = (1.0f - fabsf(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+    const float wrap_y = (1.0f - fabsf(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+    x = wrap_x;
+    y = wrap_y;
+  }
+  return float_to_snorm(x, 32767) | (float_to_snorm(y, 32767) << 16);
+}
+
+ccl_device_inline float3 octahedral_to_float3(const uint u)
+{
+  const float x = snorm_to_float(u & 0xffff, 32767);
+  const float y = snorm_to_float(u >> 16, 32767);
+  const float z = 1.0f - fabsf(x) - fabsf(y);
+  const float t = max(-z, 0.0f);
+  return normalize(make_float3(x + ((x >= 0.0f) ? -t : t), y + ((y >= 0.0f) ? -t : t), z));
+}
+
+CCL_NAMESPACE_END
@@ -40,6 +40,8 @@ typedef enum ImageDataType {
   IMAGE_DATA_TYPE_NANOVDB_FLOAT3 = 9,
   IMAGE_DATA_TYPE_NANOVDB_FPN = 10,
   IMAGE_DATA_TYPE_NANOVDB_FP16 = 11,
+  /* Image read on demand through the texture cache, CPU only. */
+  IMAGE_DATA_TYPE_TEXTURE_CACHE = 12,
 
   IMAGE_DATA_NUM_TYPES
 } ImageDataType;
@@ -86,6 +88,16 @@ typedef struct TextureInfo {
   Transform transform_3d;
 } TextureInfo;
 
+/* Data of IMAGE_DATA_TYPE_TEXTURE_CACHE textures. Instead of pixels the texture holds the
+ * OpenImageIO texture system and the handle of the image file, which is read in tiles and at
+ * the mipmap level needed by the lookups. */
+typedef struct TextureCacheImage {
+  /* OIIO::TextureSystem */
+  void *texture_system;
+  /* OIIO::TextureSystem::TextureHandle */
+  void *texture_handle;
+} TextureCacheImage;
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_TEXTURE_H__ */
@@ -49,6 +49,7 @@ class DATA_PT_pose(ArmatureButtonsPanel, Panel):
         arm = context.armature
 
         layout.row().prop(arm, "pose_position", expand=True)
+        layout.prop(arm, "use_batched_pose_evaluation")
 
 
 class DATA_PT_display(ArmatureButtonsPanel, Panel):
@@ -269,6 +269,7 @@ class GRAPH_MT_channel(Menu):
 
         if context.space_data.mode == 'DRIVERS':
             layout.operator("graph.driver_delete_invalid")
+            layout.operator("anim.drivers_report_python")
 
         layout.separator()
         layout.operator("anim.channels_group")
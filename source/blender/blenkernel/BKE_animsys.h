@@ -349,6 +349,14 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/**
+ * Invalidate the resolved RNA paths of all evaluated IDs, see #AnimData.binding_cache. Has to be
+ * called whenever the evaluated data that the paths point to may have been reallocated without
+ * the ID being copied again, like when the relations are rebuilt or a pose is rebuilt.
+ */
+void BKE_animsys_binding_cache_invalidate_all();
+void BKE_animsys_binding_cache_free(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
@@ -14,6 +14,7 @@
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_set.hh"
+#include "BLI_span.hh"
 
 #include "DNA_armature_types.h"
 
@@ -33,6 +34,9 @@ struct bGPDstroke;
 struct bPose;
 struct bPoseChannel;
 struct MDeformVert;
+namespace blender::bke {
+struct ArmatureDeformWeightCache;
+}  // namespace blender::bke
 
 struct EditBone {
   EditBone *next, *prev;
@@ -606,6 +610,15 @@ void BKE_pose_constraints_evaluate(Depsgraph *depsgraph,
 
 void BKE_pose_bone_done(Depsgraph *depsgraph, Object *object, int pchan_index);
 
+/**
+ * Evaluate the pose and final matrices of several bones in the given order, which must have
+ * parents before children. Used for bones without constraints or IK, see #ARM_BATCH_POSE_EVAL.
+ */
+void BKE_pose_eval_bone_batch(Depsgraph *depsgraph,
+                              Scene *scene,
+                              Object *object,
+                              blender::Span<int> pchan_indices);
+
 void BKE_pose_eval_bbone_segments(Depsgraph *depsgraph, Object *object, int pchan_index);
 
 void BKE_pose_iktree_evaluate(Depsgraph *depsgraph,
@@ -629,6 +642,15 @@ void BKE_pose_eval_cleanup(Depsgraph *depsgraph, Scene *scene, Object *object);
 /* Note that we could have a 'BKE_armature_deform_coords' that doesn't take object data
  * currently there are no callers for this though. */
 
+/**
+ * Vertex group weights of a mesh prepared for armature deformation. It is rebuilt automatically
+ * when the weights or the vertex groups of the bones change, so it can be kept by the caller
+ * between evaluations, e.g. in the modifier runtime data. Without a cache, the weights are read
+ * from the #MDeformVert of every vertex instead.
+ */
+blender::bke::ArmatureDeformWeightCache *BKE_armature_deform_weight_cache_new();
+void BKE_armature_deform_weight_cache_free(blender::bke::ArmatureDeformWeightCache *cache);
+
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
                                                     const Object *ob_target,
                                                     float (*vert_coords)[3],
@@ -658,7 +680,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                                           int deformflag,
                                           float (*vert_coords_prev)[3],
                                           const char *defgrp_name,
-                                          const Mesh *me_target);
+                                          const Mesh *me_target,
+                                          blender::bke::ArmatureDeformWeightCache *weight_cache);
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                                               const Object *ob_target,
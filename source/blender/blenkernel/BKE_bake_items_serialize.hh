@@ -45,12 +45,26 @@ class BlobReader {
                                             FunctionRef<bool(std::istream &)> fn) const;
 };
 
+/**
+ * Compression that is applied to arrays before they are passed to a #BlobWriter.
+ */
+enum class BlobCompression {
+  None,
+  /**
+   * The bytes of every element are shuffled so that bytes of the same significance are stored
+   * next to each other. The result is compressed with zstd in independent chunks, so that they can
+   * be encoded and decoded in parallel.
+   */
+  Zstd,
+};
+
 /**
  * Abstract base class for writing binary data.
  */
 class BlobWriter {
  protected:
   int64_t total_written_size_ = 0;
+  BlobCompression compression_ = BlobCompression::None;
 
  public:
   virtual ~BlobWriter() = default;
@@ -74,6 +88,16 @@ class BlobWriter {
   {
     return total_written_size_;
   }
+
+  BlobCompression compression() const
+  {
+    return compression_;
+  }
+
+  void set_compression(const BlobCompression compression)
+  {
+    compression_ = compression;
+  }
 };
 
 /**
@@ -270,6 +270,9 @@ enum {
 
   G_DEBUG_GHOST = (1 << 23),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 24), /* Debug Wintab. */
+
+  G_DEBUG_GEOMETRY_NODES_PROFILE = (1 << 25), /* Geometry nodes profiling and trace export. */
+  G_DEBUG_DEPSGRAPH_TRACE = (1 << 26),        /* Depsgraph evaluation timeline trace export. */
 };
 
 #define G_DEBUG_ALL \
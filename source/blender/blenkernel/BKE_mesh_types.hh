@@ -94,6 +94,15 @@ struct LooseEdgeCache : public LooseGeomCache {};
  */
 struct LooseVertCache : public LooseGeomCache {};
 
+/**
+ * Cached map from every element of one domain to the connected elements of another domain, stored
+ * as offsets and sorted indices (CSR layout). See #Mesh::vert_to_edge_map().
+ */
+struct GroupedMapCache {
+  Array<int> offsets;
+  Array<int> indices;
+};
+
 struct TrianglesCache {
   SharedCache<Array<int3>> data;
   bool frozen = false;
@@ -210,6 +219,10 @@ struct MeshRuntime {
   SharedCache<Array<int>> vert_to_corner_map_cache;
   /** Cache of face indices for each face corner. */
   SharedCache<Array<int>> corner_to_face_map_cache;
+  /** Cache of the edges connected to each vertex. See #Mesh::vert_to_edge_map(). */
+  SharedCache<GroupedMapCache> vert_to_edge_map_cache;
+  /** Cache of the face corners using each edge. See #Mesh::edge_to_corner_map(). */
+  SharedCache<GroupedMapCache> edge_to_corner_map_cache;
   /** Cache of data about edges not used by faces. See #Mesh::loose_edges(). */
   SharedCache<LooseEdgeCache> loose_edges_cache;
   /** Cache of data about vertices not used by edges. See #Mesh::loose_verts(). */
@@ -309,6 +309,7 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
 
   /* free driver array cache */
   MEM_SAFE_FREE(adt->driver_array);
+  BKE_animsys_binding_cache_free(adt);
 
   /* free overrides */
   /* TODO... */
@@ -420,6 +421,7 @@ AnimData *BKE_animdata_copy_in_lib(Main *bmain,
   /* duplicate drivers (F-Curves) */
   BKE_fcurves_copy(&dadt->drivers, &adt->drivers);
   dadt->driver_array = nullptr;
+  dadt->binding_cache = nullptr;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1495,6 +1497,7 @@ void BKE_animdata_blend_read_data(BlendDataReader *reader, ID *id)
   BLO_read_struct_list(reader, FCurve, &adt->drivers);
   BKE_fcurve_blend_read_data_listbase(reader, &adt->drivers);
   adt->driver_array = nullptr;
+  adt->binding_cache = nullptr;
 
   /* link overrides */
   /* TODO... */
@@ -6,6 +6,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cfloat>
 #include <cmath>
 #include <cstddef>
@@ -25,6 +27,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -913,6 +916,158 @@ void animsys_evaluate_action(PointerRNA *ptr,
   animsys_evaluate_fcurves(ptr, fcurves, anim_eval_context, flush_to_original);
 }
 
+/* ----------------------------------------- */
+
+namespace blender::bke {
+
+/**
+ * Resolved RNA paths of the F-Curves of a legacy action assigned to an evaluated ID.
+ *
+ * Resolving the RNA path is the most expensive part of evaluating most F-Curves. The resolved
+ * pointers stay valid as long as the evaluated ID is not copied again (which frees the cache
+ * together with the #AnimData), and as long as nothing reallocates the animated data in place,
+ * see #BKE_animsys_binding_cache_invalidate_all.
+ */
+struct AnimDataBindingCache {
+  /** Value of #binding_cache_generation when the paths were resolved. */
+  uint64_t generation;
+  /**
+   * The action the paths were resolved for. F-Curve pointers can't identify the F-Curves, because
+   * a new copy of the action may reuse the memory of the previous one.
+   */
+  uint32_t action_session_uid;
+  int64_t fcurves_num;
+  /** Indexed like the F-Curves. The property is null if the path could not be resolved. */
+  Vector<PathResolvedRNA> bindings;
+  /** Order in which the values are written, grouped by the animated struct. */
+  Vector<int> write_order;
+  /** Storage for the evaluated values, to avoid reallocating it on every evaluation. */
+  Vector<float> values;
+  /**
+   * False if any of the paths cannot be cached, in which case the F-Curves are evaluated without
+   * the cache.
+   */
+  bool is_supported;
+};
+
+}  // namespace blender::bke
+
+static std::atomic<uint64_t> binding_cache_generation = 0;
+
+/** Data which is reallocated during evaluation, so pointers to it cannot be kept. */
+static bool animsys_binding_cache_id_type_supported(const ID_Type id_type)
+{
+  return !ELEM(id_type,
+               ID_ME,
+               ID_CU_LEGACY,
+               ID_MB,
+               ID_LT,
+               ID_CV,
+               ID_PT,
+               ID_VO,
+               ID_GD_LEGACY,
+               ID_GP);
+}
+
+static void animsys_binding_cache_build(bke::AnimDataBindingCache &cache,
+                                        PointerRNA *ptr,
+                                        const bAction &action,
+                                        const Span<FCurve *> fcurves,
+                                        const uint64_t generation)
+{
+  cache.generation = generation;
+  cache.action_session_uid = action.id.session_uid;
+  cache.fcurves_num = fcurves.size();
+  cache.bindings.reinitialize(fcurves.size());
+  cache.write_order.clear();
+  cache.is_supported = animsys_binding_cache_id_type_supported(GS(ptr->owner_id->name));
+
+  for (const int i : fcurves.index_range()) {
+    const FCurve *fcu = fcurves[i];
+    PathResolvedRNA &binding = cache.bindings[i];
+    /* Drivers on action F-Curves may read values written by previous F-Curves, so all values
+     * cannot be evaluated before they are written. */
+    if (fcu->driver != nullptr) {
+      cache.is_supported = false;
+    }
+    if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &binding)) {
+      binding.prop = nullptr;
+      continue;
+    }
+    /* Paths into other IDs point to data which may be copied again without this cache being
+     * freed. */
+    if (binding.ptr.owner_id != ptr->owner_id) {
+      cache.is_supported = false;
+    }
+    cache.write_order.append(i);
+  }
+
+  /* Writing all properties of a struct together helps cache locality. The sort is stable so that
+   * the last F-Curve still wins when several F-Curves animate the same property. */
+  std::stable_sort(cache.write_order.begin(), cache.write_order.end(), [&](int a, int b) {
+    return cache.bindings[a].ptr.data < cache.bindings[b].ptr.data;
+  });
+}
+
+/**
+ * Evaluate the legacy action assigned to the evaluated ID using the cached bindings.
+ * \return False if the cache cannot be used, the action has to be evaluated normally then.
+ */
+static bool animsys_evaluate_action_cached(PointerRNA *ptr,
+                                           AnimData &adt,
+                                           const AnimationEvalContext *anim_eval_context,
+                                           const bool flush_to_original)
+{
+  if (!DEG_is_evaluated_id(ptr->owner_id)) {
+    return false;
+  }
+  bAction *act = adt.action;
+  if (!act->wrap().is_action_legacy()) {
+    return false;
+  }
+  action_idcode_patch_check(ptr->owner_id, act);
+
+  const Vector<FCurve *> fcurves = animrig::legacy::fcurves_all(act);
+  const uint64_t generation = binding_cache_generation.load(std::memory_order_relaxed);
+  if (adt.binding_cache == nullptr) {
+    adt.binding_cache = MEM_new<bke::AnimDataBindingCache>(__func__);
+    animsys_binding_cache_build(*adt.binding_cache, ptr, *act, fcurves, generation);
+  }
+  else if (adt.binding_cache->generation != generation ||
+           adt.binding_cache->action_session_uid != act->id.session_uid ||
+           adt.binding_cache->fcurves_num != fcurves.size() ||
+           /* The evaluated action has been copied again in this evaluation, its F-Curves may
+            * animate different paths now. */
+           (act->id.recalc & ID_RECALC_SYNC_TO_EVAL))
+  {
+    animsys_binding_cache_build(*adt.binding_cache, ptr, *act, fcurves, generation);
+  }
+  bke::AnimDataBindingCache &cache = *adt.binding_cache;
+  if (!cache.is_supported) {
+    return false;
+  }
+
+  /* Evaluate all F-Curves in one flat loop first, then write the values. */
+  cache.values.resize(fcurves.size());
+  for (const int i : cache.write_order) {
+    FCurve *fcu = fcurves[i];
+    if (is_fcurve_evaluatable(fcu)) {
+      cache.values[i] = calculate_fcurve(&cache.bindings[i], fcu, anim_eval_context);
+    }
+  }
+  for (const int i : cache.write_order) {
+    FCurve *fcu = fcurves[i];
+    if (!is_fcurve_evaluatable(fcu)) {
+      continue;
+    }
+    BKE_animsys_write_to_rna_path(&cache.bindings[i], cache.values[i]);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, cache.values[i]);
+    }
+  }
+  return true;
+}
+
 void animsys_blend_in_action(PointerRNA *ptr,
                              bAction *act,
                              const int32_t action_slot_handle,
@@ -4011,7 +4166,9 @@ void BKE_animsys_evaluate_animdata(ID *id,
         blender::animrig::evaluate_and_apply_action(
             id_ptr, action, adt->slot_handle, *anim_eval_context, flush_to_original);
       }
-      else {
+      else if (!animsys_evaluate_action_cached(
+                   &id_ptr, *adt, anim_eval_context, flush_to_original))
+      {
         animsys_evaluate_action(
             &id_ptr, adt->action, animrig::Slot::unassigned, anim_eval_context, flush_to_original);
       }
@@ -4219,6 +4376,17 @@ void BKE_animsys_update_driver_array(ID *id)
   }
 }
 
+void BKE_animsys_binding_cache_invalidate_all()
+{
+  binding_cache_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BKE_animsys_binding_cache_free(AnimData *adt)
+{
+  MEM_delete(adt->binding_cache);
+  adt->binding_cache = nullptr;
+}
+
 void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCurve *fcu_orig)
 {
   BLI_assert(fcu_orig != nullptr);
@@ -42,6 +42,7 @@
 #include "BKE_action.hh"
 #include "BKE_anim_data.hh"
 #include "BKE_anim_visualization.h"
+#include "BKE_animsys.h"
 #include "BKE_armature.hh"
 #include "BKE_constraint.h"
 #include "BKE_curve.hh"
@@ -2782,6 +2783,9 @@ void BKE_pose_rebuild(Main *bmain, Object *ob, bArmature *arm, const bool do_id_
   /* clear */
   BKE_pose_clear_pointers(pose);
 
+  /* Animation keeps pointers to pose channels of evaluated objects. */
+  BKE_animsys_binding_cache_invalidate_all();
+
   /* first step, check if all channels are there */
   Bone *prev_bone = nullptr;
   LISTBASE_FOREACH (Bone *, bone, &arm->bonebase) {
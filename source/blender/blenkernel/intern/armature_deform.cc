@@ -17,11 +17,15 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -229,6 +233,113 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Armature Deform Weight Table
+ *
+ * Walking the #MDeformVert of every vertex and mapping its vertex groups to pose channels is a
+ * significant part of the deformation cost for dense meshes. The table stores the same weights in
+ * a compressed sparse row layout, without zero weights and without groups that don't map to a
+ * deforming bone, so that it only has to be rebuilt when the weights or the mapping change.
+ * \{ */
+
+namespace blender::bke {
+
+struct ArmatureDeformWeightCache {
+  /** The weights of vertex `i` are stored in the range `offsets[i]` to `offsets[i + 1]`. */
+  Array<int> offsets;
+  /** Vertex group index of every weight. */
+  Array<int> groups;
+  Array<float> weights;
+  /**
+   * Vertices that are in a vertex group of a deforming bone, including zero weights. Other
+   * vertices fall back to envelope deformation.
+   */
+  Array<bool> has_bone_group;
+
+  /** The data the table was built from, to detect when it has to be rebuilt. */
+  WeakImplicitSharingPtr dverts_sharing_info;
+  int64_t dverts_version = -1;
+  const MDeformVert *dverts = nullptr;
+  /** Vertex groups that mapped to a deforming bone. */
+  Array<bool> used_groups;
+};
+
+}  // namespace blender::bke
+
+using blender::bke::ArmatureDeformWeightCache;
+
+blender::bke::ArmatureDeformWeightCache *BKE_armature_deform_weight_cache_new()
+{
+  return MEM_new<ArmatureDeformWeightCache>(__func__);
+}
+
+void BKE_armature_deform_weight_cache_free(blender::bke::ArmatureDeformWeightCache *cache)
+{
+  MEM_delete(cache);
+}
+
+static bool armature_deform_weight_table_is_valid(const ArmatureDeformWeightCache &table,
+                                                  const blender::ImplicitSharingInfo &sharing_info,
+                                                  const blender::Span<MDeformVert> dverts,
+                                                  const blender::Span<bool> used_groups)
+{
+  return table.dverts_sharing_info == &sharing_info &&
+         table.dverts_version == sharing_info.version() && table.dverts == dverts.data() &&
+         table.offsets.size() == dverts.size() + 1 && table.used_groups.as_span() == used_groups;
+}
+
+static void armature_deform_weight_table_build(ArmatureDeformWeightCache &table,
+                                               const blender::ImplicitSharingInfo &sharing_info,
+                                               const blender::Span<MDeformVert> dverts,
+                                               const blender::Span<bool> used_groups)
+{
+  using namespace blender;
+  const auto is_bone_group = [&](const MDeformWeight &dw) {
+    return used_groups.index_range().contains(dw.def_nr) && used_groups[dw.def_nr];
+  };
+
+  table.offsets.reinitialize(dverts.size() + 1);
+  table.has_bone_group.reinitialize(dverts.size());
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      int count = 0;
+      bool has_bone_group = false;
+      for (const MDeformWeight &dw : Span(dverts[i].dw, dverts[i].totweight)) {
+        if (is_bone_group(dw)) {
+          has_bone_group = true;
+          count += (dw.weight != 0.0f);
+        }
+      }
+      table.offsets[i] = count;
+      table.has_bone_group[i] = has_bone_group;
+    }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(table.offsets);
+
+  table.groups.reinitialize(offsets.total_size());
+  table.weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      int dst = offsets[i].start();
+      for (const MDeformWeight &dw : Span(dverts[i].dw, dverts[i].totweight)) {
+        if (is_bone_group(dw) && dw.weight != 0.0f) {
+          table.groups[dst] = dw.def_nr;
+          table.weights[dst] = dw.weight;
+          dst++;
+        }
+      }
+    }
+  });
+
+  sharing_info.add_weak_user();
+  table.dverts_sharing_info = WeakImplicitSharingPtr(&sharing_info);
+  table.dverts_version = sharing_info.version();
+  table.dverts = dverts.data();
+  table.used_groups = used_groups;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Armature Deform #BKE_armature_deform_coords API
  *
@@ -255,6 +366,9 @@ struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /** Optional replacement for the weights in #dverts, see #ArmatureDeformWeightCache. */
+  const ArmatureDeformWeightCache *weight_table;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -264,6 +378,68 @@ struct ArmatureUserdata {
   } bmesh;
 };
 
+/**
+ * Accumulate the deformation of the bones in the weight table of vertex `i`.
+ * With linear blending, plain bones only add their weighted matrix to a blended matrix that
+ * transforms the coordinate once at the end, instead of transforming it by every bone.
+ *
+ * \return True if the vertex is in any vertex group of a deforming bone.
+ */
+static bool armature_vert_accumulate_weight_table(const ArmatureUserdata *data,
+                                                  const int i,
+                                                  const float co[3],
+                                                  float vec[3],
+                                                  DualQuat *dq,
+                                                  float mat[3][3],
+                                                  const bool full_deform,
+                                                  float *contrib)
+{
+  const ArmatureDeformWeightCache &table = *data->weight_table;
+  const blender::IndexRange range = blender::OffsetIndices<int>(table.offsets)[i];
+
+  float blend_mat[4][4];
+  float blend_weight = 0.0f;
+  zero_m4(blend_mat);
+
+  for (const int j : range) {
+    const bPoseChannel *pchan = data->pchan_from_defbase[table.groups[j]];
+    const Bone *bone = pchan->bone;
+    float weight = table.weights[j];
+
+    if (bone->flag & BONE_MULT_VG_ENV) {
+      weight *= distfactor_to_bone(
+          co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+    }
+
+    const bool use_bbone = bone->segments > 1 &&
+                           pchan->runtime.bbone_segments == bone->segments;
+    if (dq || use_bbone) {
+      pchan_bone_deform(pchan, weight, vec, dq, mat, co, full_deform, contrib);
+    }
+    else if (weight != 0.0f) {
+      madd_m4_m4m4fl(blend_mat, blend_mat, pchan->chan_mat, weight);
+      blend_weight += weight;
+      (*contrib) += weight;
+    }
+  }
+
+  if (blend_weight != 0.0f) {
+    /* Same as accumulating `weight * (chan_mat * co - co)` for every bone. */
+    float tmp[3];
+    mul_v3_m4v3(tmp, blend_mat, co);
+    madd_v3_v3fl(tmp, co, -blend_weight);
+    add_v3_v3(vec, tmp);
+
+    if (full_deform) {
+      float tmpmat[3][3];
+      copy_m3_m4(tmpmat, blend_mat);
+      add_m3_m3m3(mat, mat, tmpmat);
+    }
+  }
+
+  return table.has_bone_group[i];
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -338,7 +514,21 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+  if (data->weight_table) {
+    const bool deformed = armature_vert_accumulate_weight_table(
+        data, i, co, vec, dq, smat, full_deform, &contrib);
+    /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
+    if (!deformed && use_envelope) {
+      for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
+           pchan = pchan->next)
+      {
+        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+          contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
+        }
+      }
+    }
+  }
+  else if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     uint j;
@@ -490,7 +680,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         const char *defgrp_name,
                                         blender::Span<MDeformVert> dverts,
                                         const Mesh *me_target,
-                                        const BMEditMesh *em_target)
+                                        const BMEditMesh *em_target,
+                                        ArmatureDeformWeightCache *weight_cache)
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
   bPoseChannel **pchan_from_defbase = nullptr;
@@ -569,8 +760,31 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.dverts_len = dverts.size();
   data.pchan_from_defbase = pchan_from_defbase;
   data.defbase_len = defbase_len;
+  data.weight_table = nullptr;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
+  /* The cache is only used for meshes, where the implicit sharing version of the weights layer
+   * tells whether the weights changed since the table was built. */
+  if (weight_cache && use_dverts && me_target && em_target == nullptr &&
+      !dverts.is_empty() && dverts.data() == me_target->deform_verts().data())
+  {
+    const int layer_index = CustomData_get_layer_index(&me_target->vert_data, CD_MDEFORMVERT);
+    const blender::ImplicitSharingInfo *sharing_info =
+        me_target->vert_data.layers[layer_index].sharing_info;
+    if (sharing_info) {
+      blender::Array<bool> used_groups(defbase_len);
+      for (const int i : used_groups.index_range()) {
+        used_groups[i] = pchan_from_defbase[i] != nullptr;
+      }
+      if (!armature_deform_weight_table_is_valid(
+              *weight_cache, *sharing_info, dverts, used_groups))
+      {
+        armature_deform_weight_table_build(*weight_cache, *sharing_info, dverts, used_groups);
+      }
+      data.weight_table = weight_cache;
+    }
+  }
+
   float obinv[4][4];
   invert_m4_m4(obinv, ob_target->object_to_world().ptr());
 
@@ -629,6 +843,7 @@ void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
                               defgrp_name,
                               dverts,
                               nullptr,
+                              nullptr,
                               nullptr);
 }
 
@@ -659,6 +874,7 @@ void BKE_armature_deform_coords_with_curves(
       defgrp_name.c_str(),
       dverts,
       nullptr,
+      nullptr,
       nullptr);
 }
 
@@ -670,7 +886,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                                           int deformflag,
                                           float (*vert_coords_prev)[3],
                                           const char *defgrp_name,
-                                          const Mesh *me_target)
+                                          const Mesh *me_target,
+                                          ArmatureDeformWeightCache *weight_cache)
 {
   const ListBase *defbase = BKE_id_defgroup_list_get(static_cast<const ID *>(ob_target->data));
   blender::Span<MDeformVert> dverts;
@@ -696,7 +913,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                               defgrp_name,
                               dverts,
                               me_target,
-                              nullptr);
+                              nullptr,
+                              weight_cache);
 }
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
@@ -721,7 +939,8 @@ void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                               defgrp_name,
                               {},
                               nullptr,
-                              em_target);
+                              em_target,
+                              nullptr);
 }
 
 /** \} */
@@ -972,6 +972,17 @@ void BKE_pose_bone_done(Depsgraph *depsgraph, Object *object, int pchan_index)
   }
 }
 
+void BKE_pose_eval_bone_batch(Depsgraph *depsgraph,
+                              Scene *scene,
+                              Object *object,
+                              const blender::Span<int> pchan_indices)
+{
+  for (const int pchan_index : pchan_indices) {
+    BKE_pose_eval_bone(depsgraph, scene, object, pchan_index);
+    BKE_pose_bone_done(depsgraph, object, pchan_index);
+  }
+}
+
 void BKE_pose_eval_bbone_segments(Depsgraph *depsgraph, Object *object, int pchan_index)
 {
   const bArmature *armature = (bArmature *)object->data;
@@ -17,6 +17,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_path_utils.hh"
+#include "BLI_task.hh"
 
 #include "DNA_material_types.h"
 #include "DNA_modifier_types.h"
@@ -28,6 +29,7 @@
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -326,6 +328,218 @@ static std::optional<eCustomDataType> get_data_type_from_io_name(const StringRef
   return eCustomDataType(domain);
 }
 
+/**
+ * Compressed arrays are split into chunks of this size which are compressed independently. This
+ * allows encoding and decoding them in parallel.
+ */
+static constexpr int64_t blob_compression_chunk_size = 1 << 20;
+/** Smaller arrays are not compressed, because the overhead outweighs the benefit. */
+static constexpr int64_t blob_compression_min_size = 1024;
+static constexpr int blob_compression_level = 3;
+
+/**
+ * Reorder the bytes so that all bytes with the same index within an element are next to each
+ * other. This typically improves the compression ratio of numeric data a lot, because e.g. the
+ * exponents of neighboring floats are often the same.
+ */
+static void shuffle_bytes(const Span<std::byte> src,
+                          const int64_t element_size,
+                          MutableSpan<std::byte> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  BLI_assert(src.size() % element_size == 0);
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t byte_i : IndexRange(element_size)) {
+    std::byte *dst_plane = dst.data() + byte_i * elements_num;
+    for (const int64_t i : IndexRange(elements_num)) {
+      dst_plane[i] = src[i * element_size + byte_i];
+    }
+  }
+}
+
+/** Inverse of #shuffle_bytes. */
+static void unshuffle_bytes(const Span<std::byte> src,
+                            const int64_t element_size,
+                            MutableSpan<std::byte> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  BLI_assert(src.size() % element_size == 0);
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t byte_i : IndexRange(element_size)) {
+    const std::byte *src_plane = src.data() + byte_i * elements_num;
+    for (const int64_t i : IndexRange(elements_num)) {
+      dst[i * element_size + byte_i] = src_plane[i];
+    }
+  }
+}
+
+/**
+ * Compress the data if the writer requests it. The returned value is null if the data should be
+ * stored uncompressed, e.g. because compression did not reduce the size.
+ */
+static std::shared_ptr<DictionaryValue> write_blob_compressed(BlobWriter &blob_writer,
+                                                              BlobWriteSharing &blob_sharing,
+                                                              const void *data,
+                                                              const int64_t size_in_bytes,
+                                                              const int64_t element_size)
+{
+  const Span<std::byte> src{static_cast<const std::byte *>(data), size_in_bytes};
+  const int64_t chunks_num = (size_in_bytes + blob_compression_chunk_size - 1) /
+                             blob_compression_chunk_size;
+
+  Array<Vector<std::byte>> compressed_chunks(chunks_num);
+  std::atomic<bool> any_error = false;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    Vector<std::byte> shuffled;
+    for (const int64_t chunk_i : range) {
+      const Span<std::byte> chunk = src.slice_safe(chunk_i * blob_compression_chunk_size,
+                                                   blob_compression_chunk_size);
+      shuffled.resize(chunk.size());
+      shuffle_bytes(chunk, element_size, shuffled);
+      Vector<std::byte> &compressed = compressed_chunks[chunk_i];
+      compressed.resize(ZSTD_compressBound(chunk.size()));
+      const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                                   compressed.size(),
+                                                   shuffled.data(),
+                                                   shuffled.size(),
+                                                   blob_compression_level);
+      if (ZSTD_isError(compressed_size)) {
+        any_error = true;
+        return;
+      }
+      compressed.resize(compressed_size);
+    }
+  });
+  if (any_error) {
+    return {};
+  }
+
+  int64_t compressed_size = 0;
+  for (const Vector<std::byte> &compressed : compressed_chunks) {
+    compressed_size += compressed.size();
+  }
+  if (compressed_size >= size_in_bytes) {
+    return {};
+  }
+
+  Vector<std::byte> buffer;
+  buffer.reserve(compressed_size);
+  for (const Vector<std::byte> &compressed : compressed_chunks) {
+    buffer.extend(compressed);
+  }
+
+  auto io_data = blob_sharing.write_deduplicated(blob_writer, buffer.data(), buffer.size());
+  io_data->append_str("compression", "zstd");
+  io_data->append_int("shuffle", element_size);
+  io_data->append_int("chunk_size", blob_compression_chunk_size);
+  io_data->append_int("uncompressed_size", size_in_bytes);
+  auto io_chunks = io_data->append_array("chunks");
+  for (const Vector<std::byte> &compressed : compressed_chunks) {
+    io_chunks->append_int(int(compressed.size()));
+  }
+  return io_data;
+}
+
+static std::shared_ptr<DictionaryValue> write_blob_data(BlobWriter &blob_writer,
+                                                        BlobWriteSharing &blob_sharing,
+                                                        const void *data,
+                                                        const int64_t size_in_bytes,
+                                                        const int64_t element_size)
+{
+  if (blob_writer.compression() == BlobCompression::Zstd &&
+      size_in_bytes >= blob_compression_min_size)
+  {
+    if (auto io_data = write_blob_compressed(
+            blob_writer, blob_sharing, data, size_in_bytes, element_size))
+    {
+      return io_data;
+    }
+  }
+  return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+}
+
+[[nodiscard]] static bool read_blob_compressed(const BlobReader &blob_reader,
+                                               const DictionaryValue &io_data,
+                                               const BlobSlice &slice,
+                                               const int64_t bytes_num,
+                                               void *r_data)
+{
+  if (io_data.lookup_str("compression") != "zstd") {
+    return false;
+  }
+  const int64_t element_size = io_data.lookup_int("shuffle").value_or(1);
+  const int64_t chunk_size = io_data.lookup_int("chunk_size").value_or(0);
+  const std::optional<int64_t> uncompressed_size = io_data.lookup_int("uncompressed_size");
+  const io::serialize::ArrayValue *io_chunks = io_data.lookup_array("chunks");
+  if (!io_chunks || uncompressed_size != bytes_num || element_size <= 0 || chunk_size <= 0 ||
+      chunk_size % element_size != 0 || bytes_num % element_size != 0)
+  {
+    return false;
+  }
+  const int64_t chunks_num = (bytes_num + chunk_size - 1) / chunk_size;
+  if (io_chunks->elements().size() != chunks_num) {
+    return false;
+  }
+  Array<int64_t> chunk_offsets(chunks_num + 1);
+  chunk_offsets[0] = 0;
+  for (const int64_t chunk_i : IndexRange(chunks_num)) {
+    const io::serialize::IntValue *io_size = io_chunks->elements()[chunk_i]->as_int_value();
+    if (!io_size) {
+      return false;
+    }
+    chunk_offsets[chunk_i + 1] = chunk_offsets[chunk_i] + io_size->value();
+  }
+  if (chunk_offsets.last() != slice.range.size()) {
+    return false;
+  }
+
+  Array<std::byte> compressed(slice.range.size(), NoInitialization());
+  if (!blob_reader.read(slice, compressed.data())) {
+    return false;
+  }
+
+  const MutableSpan<std::byte> dst{static_cast<std::byte *>(r_data), bytes_num};
+  std::atomic<bool> any_error = false;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    Vector<std::byte> shuffled;
+    for (const int64_t chunk_i : range) {
+      const IndexRange compressed_range = IndexRange::from_begin_end(chunk_offsets[chunk_i],
+                                                                     chunk_offsets[chunk_i + 1]);
+      const MutableSpan<std::byte> dst_chunk = dst.slice_safe(chunk_i * chunk_size, chunk_size);
+      shuffled.resize(dst_chunk.size());
+      const size_t decompressed_size = ZSTD_decompress(shuffled.data(),
+                                                       shuffled.size(),
+                                                       compressed.data() + compressed_range.start(),
+                                                       compressed_range.size());
+      if (ZSTD_isError(decompressed_size) || decompressed_size != dst_chunk.size()) {
+        any_error = true;
+        return;
+      }
+      unshuffle_bytes(shuffled, element_size, dst_chunk);
+    }
+  });
+  return !any_error;
+}
+
+/**
+ * Read the data referenced by the slice into the given buffer. Decompression is done if
+ * necessary.
+ */
+[[nodiscard]] static bool read_blob_data(const BlobReader &blob_reader,
+                                         const DictionaryValue &io_data,
+                                         const BlobSlice &slice,
+                                         const int64_t bytes_num,
+                                         void *r_data)
+{
+  if (io_data.lookup("compression")) {
+    return read_blob_compressed(blob_reader, io_data, slice, bytes_num, r_data);
+  }
+  if (slice.range.size() != bytes_num) {
+    return false;
+  }
+  return blob_reader.read(slice, r_data);
+}
+
 /**
  * Write the data and remember which endianness the data had.
  */
@@ -333,9 +547,10 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
     const void *data,
-    const int64_t size_in_bytes)
+    const int64_t size_in_bytes,
+    const int64_t element_size)
 {
-  auto io_data = blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  auto io_data = write_blob_data(blob_writer, blob_sharing, data, size_in_bytes, element_size);
   if (ENDIAN_ORDER == B_ENDIAN) {
     io_data->append_str("endian", get_endian_io_name(ENDIAN_ORDER));
   }
@@ -355,10 +570,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != element_size * elements_num) {
-    return false;
-  }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (!read_blob_data(blob_reader, io_data, *slice, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -390,7 +602,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                                              const void *data,
                                                              const int64_t size_in_bytes)
 {
-  return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  return write_blob_data(blob_writer, blob_sharing, data, size_in_bytes, 1);
 }
 
 /** Read bytes ignoring endianness. */
@@ -403,10 +615,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != bytes_num) {
-    return false;
-  }
-  return blob_reader.read(*slice, r_data);
+  return read_blob_data(blob_reader, io_data, *slice, bytes_num, r_data);
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
@@ -418,8 +627,12 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
   if (type.size() == 1 || type.is<ColorGeometry4b>()) {
     return write_blob_raw_bytes(blob_writer, blob_sharing, data.data(), data.size_in_bytes());
   }
+  const int64_t element_size =
+      type.is_any<float2, int2, float3, float4x4, ColorGeometry4f, math::Quaternion>() ?
+          sizeof(float) :
+          type.size();
   return write_blob_raw_data_with_endian(
-      blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+      blob_writer, blob_sharing, data.data(), data.size_in_bytes(), element_size);
 }
 
 [[nodiscard]] static bool read_blob_simple_gspan(const BlobReader &blob_reader,
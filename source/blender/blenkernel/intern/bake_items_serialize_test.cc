@@ -0,0 +1,96 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BKE_bake_items.hh"
+#include "BKE_bake_items_serialize.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_pointcloud.hh"
+
+#include "DNA_pointcloud_types.h"
+
+#include <sstream>
+
+namespace blender::bke::bake::tests {
+
+static PointCloud *create_test_pointcloud(const int points_num)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
+  MutableSpan<float3> positions = pointcloud->positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(i * 0.01f, float(i % 100), -1.0f);
+  }
+  SpanAttributeWriter<int> ids =
+      pointcloud->attributes_for_write().lookup_or_add_for_write_only_span<int>("id",
+                                                                              AttrDomain::Point);
+  for (const int i : ids.span.index_range()) {
+    ids.span[i] = i * 3;
+  }
+  ids.finish();
+  return pointcloud;
+}
+
+static void test_roundtrip(const BlobCompression compression, const bool expect_compressed)
+{
+  BKE_idtype_init();
+  const int points_num = 100000;
+
+  BakeState bake_state;
+  bake_state.items_by_id.add_new(0,
+                                 std::make_unique<GeometryBakeItem>(GeometrySet::from_pointcloud(
+                                     create_test_pointcloud(points_num))));
+
+  MemoryBlobWriter blob_writer{"test"};
+  blob_writer.set_compression(compression);
+  BlobWriteSharing write_sharing;
+  std::ostringstream meta_stream;
+  serialize_bake(bake_state, blob_writer, write_sharing, meta_stream);
+  const std::string meta = meta_stream.str();
+  EXPECT_EQ(meta.find("\"compression\"") != std::string::npos, expect_compressed);
+
+  Map<std::string, std::string> blob_by_name;
+  for (auto &&item : blob_writer.get_stream_by_name().items()) {
+    blob_by_name.add_new(item.key, item.value.stream->str());
+  }
+  MemoryBlobReader blob_reader;
+  for (auto &&item : blob_by_name.items()) {
+    blob_reader.add(item.key, Span(reinterpret_cast<const std::byte *>(item.value.data()),
+                                   int64_t(item.value.size())));
+  }
+  if (expect_compressed) {
+    EXPECT_LT(blob_writer.written_size(), points_num * int64_t(sizeof(float3) + sizeof(int)));
+  }
+
+  BlobReadSharing read_sharing;
+  std::istringstream read_stream{meta};
+  std::optional<BakeState> read_state = deserialize_bake(read_stream, blob_reader, read_sharing);
+  ASSERT_TRUE(read_state.has_value());
+  const auto *item = dynamic_cast<const GeometryBakeItem *>(
+      read_state->items_by_id.lookup(0).get());
+  ASSERT_NE(item, nullptr);
+  const PointCloud *pointcloud = item->geometry.get_pointcloud();
+  ASSERT_NE(pointcloud, nullptr);
+  ASSERT_EQ(pointcloud->totpoint, points_num);
+
+  const Span<float3> positions = pointcloud->positions();
+  const VArraySpan<int> ids = *pointcloud->attributes().lookup<int>("id", AttrDomain::Point);
+  for (const int i : IndexRange(points_num)) {
+    EXPECT_EQ(positions[i], float3(i * 0.01f, float(i % 100), -1.0f));
+    EXPECT_EQ(ids[i], i * 3);
+  }
+}
+
+TEST(bake_items_serialize, RoundtripUncompressed)
+{
+  test_roundtrip(BlobCompression::None, false);
+}
+
+TEST(bake_items_serialize, RoundtripCompressed)
+{
+  test_roundtrip(BlobCompression::Zstd, true);
+}
+
+}  // namespace blender::bke::bake::tests
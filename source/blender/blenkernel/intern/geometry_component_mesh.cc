@@ -175,19 +175,38 @@ VArray<float3> mesh_normals_varray(const Mesh &mesh,
 /** \name Attribute Access
  * \{ */
 
+/**
+ * Mix the source values of each group into the corresponding result value. Using the cached
+ * topology maps turns the domain interpolation into a gather, which avoids scattered writes and
+ * allows processing the result in parallel. The indices in every group are sorted, so the values
+ * are mixed in the same order as when iterating over the source domain.
+ */
+template<typename T>
+static void mix_grouped_values(const GroupedSpan<int> groups,
+                               const VArray<T> &old_values,
+                               MutableSpan<T> r_values)
+{
+  BLI_assert(r_values.size() == groups.size());
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+      attribute_math::DefaultMixer<T> mixer(r_values.slice(range));
+      for (const int i : range.index_range()) {
+        for (const int src_index : groups[range[i]]) {
+          mixer.mix_in(i, old_values[src_index]);
+        }
+      }
+      mixer.finalize();
+    });
+  });
+}
+
 template<typename T>
 static void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
                                                    const VArray<T> &old_values,
                                                    MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.verts_num);
-  const Span<int> corner_verts = mesh.corner_verts();
-
-  attribute_math::DefaultMixer<T> mixer(r_values);
-  for (const int corner : IndexRange(mesh.corners_num)) {
-    mixer.mix_in(corner_verts[corner], old_values[corner]);
-  }
-  mixer.finalize();
+  mix_grouped_values(mesh.vert_to_corner_map(), old_values, r_values);
 }
 
 /* A vertex is selected if all connected face corners were selected and it is not loose. */
@@ -197,29 +216,18 @@ void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
                                             MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.verts_num);
-  const Span<int> corner_verts = mesh.corner_verts();
-
-  r_values.fill(true);
-  for (const int corner : IndexRange(mesh.corners_num)) {
-    const int point_index = corner_verts[corner];
-
-    if (!old_values[corner]) {
-      r_values[point_index] = false;
+  const GroupedSpan<int> vert_to_corner_map = mesh.vert_to_corner_map();
+
+  threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+    for (const int vert : range) {
+      /* Loose vertices without corners are not selected. */
+      const Span<int> corners = vert_to_corner_map[vert];
+      r_values[vert] = !corners.is_empty() &&
+                       std::all_of(corners.begin(), corners.end(), [&](const int corner) {
+                         return old_values[corner];
+                       });
     }
-  }
-
-  /* Deselect loose vertices without corners that are still selected from the 'true' default. */
-  const LooseVertCache &loose_verts = mesh.verts_no_face();
-  if (loose_verts.count > 0) {
-    const BitSpan bits = loose_verts.is_loose_bits;
-    threading::parallel_for(bits.index_range(), 2048, [&](const IndexRange range) {
-      for (const int vert_index : range) {
-        if (bits[vert_index]) {
-          r_values[vert_index] = false;
-        }
-      }
-    });
-  }
+  });
 }
 
 static GVArray adapt_mesh_domain_corner_to_point(const Mesh &mesh, const GVArray &varray)
@@ -300,23 +308,22 @@ static void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
 {
   BLI_assert(r_values.size() == mesh.edges_num);
   const OffsetIndices faces = mesh.faces();
-  const Span<int> corner_edges = mesh.corner_edges();
-
-  attribute_math::DefaultMixer<T> mixer(r_values);
-
-  for (const int face_index : faces.index_range()) {
-    const IndexRange face = faces[face_index];
-
-    /* For every edge, mix values from the two adjacent corners (the current and next corner). */
-    for (const int corner : face) {
-      const int next_corner = mesh::face_corner_next(face, corner);
-      const int edge_index = corner_edges[corner];
-      mixer.mix_in(edge_index, old_values[corner]);
-      mixer.mix_in(edge_index, old_values[next_corner]);
+  const Span<int> corner_to_face = mesh.corner_to_face_map();
+  const GroupedSpan<int> edge_to_corner_map = mesh.edge_to_corner_map();
+
+  threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+    attribute_math::DefaultMixer<T> mixer(r_values.slice(range));
+    for (const int i : range.index_range()) {
+      /* For every edge, mix values from the two adjacent corners (the current and next corner). */
+      for (const int corner : edge_to_corner_map[range[i]]) {
+        const IndexRange face = faces[corner_to_face[corner]];
+        const int next_corner = mesh::face_corner_next(face, corner);
+        mixer.mix_in(i, old_values[corner]);
+        mixer.mix_in(i, old_values[next_corner]);
+      }
     }
-  }
-
-  mixer.finalize();
+    mixer.finalize();
+  });
 }
 
 /* An edge is selected if all corners on adjacent faces were selected. */
@@ -327,32 +334,21 @@ void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
 {
   BLI_assert(r_values.size() == mesh.edges_num);
   const OffsetIndices faces = mesh.faces();
-  const Span<int> corner_edges = mesh.corner_edges();
-
-  r_values.fill(true);
-  for (const int face_index : faces.index_range()) {
-    const IndexRange face = faces[face_index];
-
-    for (const int corner : face) {
-      const int next_corner = mesh::face_corner_next(face, corner);
-      const int edge_index = corner_edges[corner];
-      if (!old_values[corner] || !old_values[next_corner]) {
-        r_values[edge_index] = false;
-      }
+  const Span<int> corner_to_face = mesh.corner_to_face_map();
+  const GroupedSpan<int> edge_to_corner_map = mesh.edge_to_corner_map();
+
+  threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+    for (const int edge : range) {
+      /* Loose edges without corners are not selected. */
+      const Span<int> corners = edge_to_corner_map[edge];
+      r_values[edge] = !corners.is_empty() &&
+                       std::all_of(corners.begin(), corners.end(), [&](const int corner) {
+                         const IndexRange face = faces[corner_to_face[corner]];
+                         return old_values[corner] &&
+                                old_values[mesh::face_corner_next(face, corner)];
+                       });
     }
-  }
-
-  const LooseEdgeCache &loose_edges = mesh.loose_edges();
-  if (loose_edges.count > 0) {
-    /* Deselect loose edges without corners that are still selected from the 'true' default. */
-    threading::parallel_for(IndexRange(mesh.edges_num), 2048, [&](const IndexRange range) {
-      for (const int edge_index : range) {
-        if (loose_edges.is_loose_bits[edge_index]) {
-          r_values[edge_index] = false;
-        }
-      }
-    });
-  }
+  });
 }
 
 static GVArray adapt_mesh_domain_corner_to_edge(const Mesh &mesh, const GVArray &varray)
@@ -374,19 +370,7 @@ void adapt_mesh_domain_face_to_point_impl(const Mesh &mesh,
                                           MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.verts_num);
-  const OffsetIndices faces = mesh.faces();
-  const Span<int> corner_verts = mesh.corner_verts();
-
-  attribute_math::DefaultMixer<T> mixer(r_values);
-
-  for (const int face_index : faces.index_range()) {
-    const T value = old_values[face_index];
-    for (const int vert : corner_verts.slice(faces[face_index])) {
-      mixer.mix_in(vert, value);
-    }
-  }
-
-  mixer.finalize();
+  mix_grouped_values(mesh.vert_to_face_map(), old_values, r_values);
 }
 
 /* A vertex is selected if any of the connected faces were selected. */
@@ -460,18 +444,20 @@ void adapt_mesh_domain_face_to_edge_impl(const Mesh &mesh,
                                          MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.edges_num);
-  const OffsetIndices faces = mesh.faces();
-  const Span<int> corner_edges = mesh.corner_edges();
-
-  attribute_math::DefaultMixer<T> mixer(r_values);
-
-  for (const int face_index : faces.index_range()) {
-    const T value = old_values[face_index];
-    for (const int edge : corner_edges.slice(faces[face_index])) {
-      mixer.mix_in(edge, value);
-    }
-  }
-  mixer.finalize();
+  const Span<int> corner_to_face = mesh.corner_to_face_map();
+  const GroupedSpan<int> edge_to_corner_map = mesh.edge_to_corner_map();
+
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    threading::parallel_for(r_values.index_range(), 2048, [&](const IndexRange range) {
+      attribute_math::DefaultMixer<T> mixer(r_values.slice(range));
+      for (const int i : range.index_range()) {
+        for (const int corner : edge_to_corner_map[range[i]]) {
+          mixer.mix_in(i, old_values[corner_to_face[corner]]);
+        }
+      }
+      mixer.finalize();
+    });
+  });
 }
 
 /* An edge is selected if any connected face was selected. */
@@ -591,22 +577,24 @@ void adapt_mesh_domain_edge_to_corner_impl(const Mesh &mesh,
   const OffsetIndices faces = mesh.faces();
   const Span<int> corner_edges = mesh.corner_edges();
 
-  attribute_math::DefaultMixer<T> mixer(r_values);
-
-  for (const int face_index : faces.index_range()) {
-    const IndexRange face = faces[face_index];
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    /* The corners of a contiguous range of faces are contiguous as well. */
+    const IndexRange corners = faces[range];
+    attribute_math::DefaultMixer<T> mixer(r_values.slice(corners));
+    for (const int face_index : range) {
+      const IndexRange face = faces[face_index];
 
-    /* For every corner, mix the values from the adjacent edges on the face. */
-    for (const int loop_index : face) {
-      const int loop_index_prev = mesh::face_corner_prev(face, loop_index);
-      const int edge = corner_edges[loop_index];
-      const int edge_prev = corner_edges[loop_index_prev];
-      mixer.mix_in(loop_index, old_values[edge]);
-      mixer.mix_in(loop_index, old_values[edge_prev]);
+      /* For every corner, mix the values from the adjacent edges on the face. */
+      for (const int loop_index : face) {
+        const int loop_index_prev = mesh::face_corner_prev(face, loop_index);
+        const int edge = corner_edges[loop_index];
+        const int edge_prev = corner_edges[loop_index_prev];
+        mixer.mix_in(loop_index - corners.start(), old_values[edge]);
+        mixer.mix_in(loop_index - corners.start(), old_values[edge_prev]);
+      }
     }
-  }
-
-  mixer.finalize();
+    mixer.finalize();
+  });
 }
 
 /* A corner is selected if its two adjacent edges were selected. */
@@ -655,18 +643,7 @@ static void adapt_mesh_domain_edge_to_point_impl(const Mesh &mesh,
                                                  MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.verts_num);
-  const Span<int2> edges = mesh.edges();
-
-  attribute_math::DefaultMixer<T> mixer(r_values);
-
-  for (const int edge_index : IndexRange(mesh.edges_num)) {
-    const int2 &edge = edges[edge_index];
-    const T value = old_values[edge_index];
-    mixer.mix_in(edge[0], value);
-    mixer.mix_in(edge[1], value);
-  }
-
-  mixer.finalize();
+  mix_grouped_values(mesh.vert_to_edge_map(), old_values, r_values);
 }
 
 /* A vertex is selected if any connected edge was selected. */
@@ -162,6 +162,28 @@ blender::GroupedSpan<int> Mesh::vert_to_corner_map() const
   return {offsets, this->runtime->vert_to_corner_map_cache.data()};
 }
 
+blender::GroupedSpan<int> Mesh::vert_to_edge_map() const
+{
+  using namespace blender;
+  this->runtime->vert_to_edge_map_cache.ensure([&](bke::GroupedMapCache &r_data) {
+    bke::mesh::build_vert_to_edge_map(
+        this->edges(), this->verts_num, r_data.offsets, r_data.indices);
+  });
+  const bke::GroupedMapCache &cache = this->runtime->vert_to_edge_map_cache.data();
+  return {OffsetIndices<int>(cache.offsets), cache.indices};
+}
+
+blender::GroupedSpan<int> Mesh::edge_to_corner_map() const
+{
+  using namespace blender;
+  this->runtime->edge_to_corner_map_cache.ensure([&](bke::GroupedMapCache &r_data) {
+    bke::mesh::build_edge_to_corner_map(
+        this->corner_edges(), this->edges_num, r_data.offsets, r_data.indices);
+  });
+  const bke::GroupedMapCache &cache = this->runtime->edge_to_corner_map_cache.data();
+  return {OffsetIndices<int>(cache.offsets), cache.indices};
+}
+
 const blender::bke::LooseVertCache &Mesh::loose_verts() const
 {
   using namespace blender::bke;
@@ -319,6 +341,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->vert_to_face_map_cache.tag_dirty();
   mesh->runtime->vert_to_corner_map_cache.tag_dirty();
   mesh->runtime->corner_to_face_map_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
+  mesh->runtime->edge_to_corner_map_cache.tag_dirty();
   mesh->runtime->vert_normals_cache.tag_dirty();
   mesh->runtime->face_normals_cache.tag_dirty();
   mesh->runtime->corner_normals_cache.tag_dirty();
@@ -342,6 +366,8 @@ void Mesh::tag_edges_split()
   this->runtime->vert_to_face_offset_cache.tag_dirty();
   this->runtime->vert_to_face_map_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->vert_to_edge_map_cache.tag_dirty();
+  this->runtime->edge_to_corner_map_cache.tag_dirty();
   if (this->runtime->loose_edges_cache.is_cached() &&
       this->runtime->loose_edges_cache.data().count != 0)
   {
@@ -378,6 +404,7 @@ void Mesh::tag_face_winding_changed()
   this->runtime->face_normals_cache.tag_dirty();
   this->runtime->corner_normals_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->edge_to_corner_map_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
 }
 
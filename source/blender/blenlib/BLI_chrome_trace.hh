@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Utilities to record timelines of multi-threaded work and to write them in the Chrome trace
+ * event format, which can be inspected in `chrome://tracing` or Perfetto.
+ */
+
+#include <atomic>
+#include <iosfwd>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_serialize.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+
+namespace blender::chrome_trace {
+
+/**
+ * Events of type #T collected in a separate buffer per thread, so that recording does not need
+ * any synchronization. Every thread gets a small stable index, which is used as thread id in the
+ * trace so that the threads are sorted nicely.
+ */
+template<typename T> class ThreadEventBuffers : NonCopyable, NonMovable {
+ private:
+  struct ThreadEvents {
+    int thread_index;
+    Vector<T> events;
+  };
+
+  std::atomic<int> next_thread_index_ = 0;
+  threading::EnumerableThreadSpecific<ThreadEvents> thread_events_;
+
+ public:
+  ThreadEventBuffers()
+      : thread_events_([this]() { return ThreadEvents{next_thread_index_.fetch_add(1), {}}; })
+  {
+  }
+
+  /** Thread-safe, the event is stored in the buffer of the calling thread. */
+  void append(T event)
+  {
+    thread_events_.local().events.append(std::move(event));
+  }
+
+  /** Call `fn(thread_index, event)` for every recorded event. Not thread-safe. */
+  template<typename Fn> void foreach_event(const Fn &fn)
+  {
+    for (const ThreadEvents &thread : thread_events_) {
+      for (const T &event : thread.events) {
+        fn(thread.thread_index, event);
+      }
+    }
+  }
+
+  bool is_empty()
+  {
+    for (const ThreadEvents &thread : thread_events_) {
+      if (!thread.events.is_empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** Remove all events and free their memory. Not thread-safe. */
+  void clear_and_shrink()
+  {
+    for (ThreadEvents &thread : thread_events_) {
+      thread.events.clear_and_shrink();
+    }
+  }
+};
+
+/**
+ * Builds the contents of a trace file. All times are in microseconds, relative to an arbitrary
+ * start of the trace.
+ */
+class TraceWriter : NonCopyable, NonMovable {
+ private:
+  io::serialize::DictionaryValue root_;
+  io::serialize::ArrayValue *events_;
+
+ public:
+  TraceWriter();
+
+  /**
+   * Add an event for work done on a thread, shown as a bar in the timeline.
+   * \return Dictionary for additional values of the event, which are shown when it is selected.
+   */
+  io::serialize::DictionaryValue &add_complete_event(std::string name,
+                                                     std::string category,
+                                                     int thread_index,
+                                                     double start_us,
+                                                     double duration_us);
+
+  /** Add a value of a counter, counters are shown as separate graphs above the threads. */
+  void add_counter_event(std::string name, double time_us, std::string key, int64_t value);
+
+  void serialize(std::ostream &os) const;
+
+  /** \return False if the file could not be written. */
+  bool write(StringRefNull filepath) const;
+};
+
+}  // namespace blender::chrome_trace
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include "BLI_index_mask_fwd.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_virtual_array_fwd.hh"
 
 namespace blender::noise {
 
@@ -58,6 +61,40 @@ float4 hash_float_to_float4(float4 k);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Hash Functions
+ *
+ * Compute the same hashes as the functions above for many keys at once. The results are
+ * bit-identical to calling the scalar functions for every element, but the hashing is inlined
+ * into simple loops that the compiler can vectorize. Outputs may alias inputs of the same size.
+ * \{ */
+
+/** `r_hashes[i] = hash(kx[i], ky[i])`. */
+void hash(Span<uint32_t> kx, Span<uint32_t> ky, MutableSpan<uint32_t> r_hashes);
+
+/** `r_hashes[i] = hash_float(k[i])`. */
+void hash_float(Span<float3> k, MutableSpan<uint32_t> r_hashes);
+
+/** `r_values[i] = hash_float_to_float(k[i])`. */
+void hash_float_to_float(Span<float3> k, MutableSpan<float> r_values);
+
+/** `r_values[i] = hash_to_float(kx[i], ky[i])` for every index in the mask. */
+void hash_to_float(const IndexMask &mask,
+                   const VArray<int> &kx,
+                   const VArray<int> &ky,
+                   MutableSpan<float> r_values);
+
+/**
+ * `r_values[i][c] = hash_to_float(kx[i], ky[i], c)` for every index in the mask, i.e. the
+ * component index is used as third key.
+ */
+void hash_to_float3(const IndexMask &mask,
+                    const VArray<int> &kx,
+                    const VArray<int> &ky,
+                    MutableSpan<float3> r_values);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Perlin Noise
  * \{ */
@@ -0,0 +1,66 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_fileops.hh"
+
+namespace blender::chrome_trace {
+
+TraceWriter::TraceWriter()
+{
+  root_.append_str("displayTimeUnit", "ms");
+  events_ = root_.append_array("traceEvents").get();
+}
+
+io::serialize::DictionaryValue &TraceWriter::add_complete_event(std::string name,
+                                                                std::string category,
+                                                                const int thread_index,
+                                                                const double start_us,
+                                                                const double duration_us)
+{
+  io::serialize::DictionaryValue &event = *events_->append_dict();
+  event.append_str("name", std::move(name));
+  event.append_str("cat", std::move(category));
+  event.append_str("ph", "X");
+  event.append_int("pid", 1);
+  event.append_int("tid", thread_index);
+  event.append_double("ts", start_us);
+  event.append_double("dur", duration_us);
+  return *event.append_dict("args");
+}
+
+void TraceWriter::add_counter_event(std::string name,
+                                    const double time_us,
+                                    std::string key,
+                                    const int64_t value)
+{
+  io::serialize::DictionaryValue &event = *events_->append_dict();
+  event.append_str("name", std::move(name));
+  event.append_str("ph", "C");
+  event.append_int("pid", 1);
+  event.append_double("ts", time_us);
+  event.append_dict("args")->append_int(std::move(key), value);
+}
+
+void TraceWriter::serialize(std::ostream &os) const
+{
+  io::serialize::JsonFormatter formatter;
+  formatter.serialize(os, root_);
+}
+
+bool TraceWriter::write(const StringRefNull filepath) const
+{
+  fstream file(filepath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  this->serialize(file);
+  return !file.fail();
+}
+
+}  // namespace blender::chrome_trace
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstdint>
 
+#include "BLI_index_mask.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_base_safe.h"
 #include "BLI_math_matrix_types.hh"
@@ -15,6 +16,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_noise.hh"
 #include "BLI_utildefines.h"
+#include "BLI_virtual_array.hh"
 
 namespace blender::noise {
 
@@ -260,6 +262,64 @@ float4 hash_float_to_float4(float4 k)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Hash Functions
+ *
+ * The scalar hash functions are defined in this file, so they are inlined into the loops below.
+ * \{ */
+
+void hash(const Span<uint32_t> kx, const Span<uint32_t> ky, MutableSpan<uint32_t> r_hashes)
+{
+  BLI_assert(kx.size() == ky.size());
+  BLI_assert(kx.size() == r_hashes.size());
+  for (const int64_t i : r_hashes.index_range()) {
+    r_hashes[i] = hash(kx[i], ky[i]);
+  }
+}
+
+void hash_float(const Span<float3> k, MutableSpan<uint32_t> r_hashes)
+{
+  BLI_assert(k.size() == r_hashes.size());
+  for (const int64_t i : r_hashes.index_range()) {
+    r_hashes[i] = hash_float(k[i]);
+  }
+}
+
+void hash_float_to_float(const Span<float3> k, MutableSpan<float> r_values)
+{
+  BLI_assert(k.size() == r_values.size());
+  for (const int64_t i : r_values.index_range()) {
+    r_values[i] = hash_float_to_float(k[i]);
+  }
+}
+
+void hash_to_float(const IndexMask &mask,
+                   const VArray<int> &kx,
+                   const VArray<int> &ky,
+                   MutableSpan<float> r_values)
+{
+  devirtualize_varray2(kx, ky, [&](const auto kx_values, const auto ky_values) {
+    mask.foreach_index_optimized<int64_t>(
+        [&](const int64_t i) { r_values[i] = hash_to_float(kx_values[i], ky_values[i]); });
+  });
+}
+
+void hash_to_float3(const IndexMask &mask,
+                    const VArray<int> &kx,
+                    const VArray<int> &ky,
+                    MutableSpan<float3> r_values)
+{
+  devirtualize_varray2(kx, ky, [&](const auto kx_values, const auto ky_values) {
+    mask.foreach_index_optimized<int64_t>([&](const int64_t i) {
+      const uint32_t x = kx_values[i];
+      const uint32_t y = ky_values[i];
+      r_values[i] = float3(hash_to_float(x, y, 0), hash_to_float(x, y, 1), hash_to_float(x, y, 2));
+    });
+  });
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Perlin Noise
  *
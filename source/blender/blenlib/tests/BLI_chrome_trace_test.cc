@@ -0,0 +1,71 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <sstream>
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_task.hh"
+
+namespace blender::chrome_trace::tests {
+
+TEST(chrome_trace, thread_event_buffers)
+{
+  ThreadEventBuffers<int> buffers;
+  EXPECT_TRUE(buffers.is_empty());
+
+  threading::parallel_for(IndexRange(1000), 10, [&](const IndexRange range) {
+    for (const int i : range) {
+      buffers.append(i);
+    }
+  });
+  EXPECT_FALSE(buffers.is_empty());
+
+  int64_t sum = 0;
+  int events_num = 0;
+  buffers.foreach_event([&](const int thread_index, const int event) {
+    EXPECT_GE(thread_index, 0);
+    sum += event;
+    events_num++;
+  });
+  EXPECT_EQ(events_num, 1000);
+  EXPECT_EQ(sum, 999 * 1000 / 2);
+
+  buffers.clear_and_shrink();
+  EXPECT_TRUE(buffers.is_empty());
+}
+
+TEST(chrome_trace, writer)
+{
+  TraceWriter writer;
+  writer.add_complete_event("Node \"A\"\n", "Tree\\1", 2, 10.0, 5.5).append_int("size", 42);
+  writer.add_counter_event("Memory", 15.5, "in_use", 1024);
+
+  std::stringstream stream;
+  writer.serialize(stream);
+
+  io::serialize::JsonFormatter formatter;
+  const std::unique_ptr<io::serialize::Value> value = formatter.deserialize(stream);
+  const io::serialize::DictionaryValue *root = value->as_dictionary_value();
+  ASSERT_NE(root, nullptr);
+  const io::serialize::ArrayValue *events = root->lookup_array("traceEvents");
+  ASSERT_NE(events, nullptr);
+  ASSERT_EQ(events->elements().size(), 2);
+
+  const io::serialize::DictionaryValue &event = *events->elements()[0]->as_dictionary_value();
+  EXPECT_EQ(*event.lookup_str("name"), "Node \"A\"\n");
+  EXPECT_EQ(*event.lookup_str("cat"), "Tree\\1");
+  EXPECT_EQ(*event.lookup_str("ph"), "X");
+  EXPECT_EQ(*event.lookup_int("tid"), 2);
+  EXPECT_EQ(*event.lookup_double("ts"), 10.0);
+  EXPECT_EQ(*event.lookup_double("dur"), 5.5);
+  EXPECT_EQ(*event.lookup_dict("args")->lookup_int("size"), 42);
+
+  const io::serialize::DictionaryValue &counter = *events->elements()[1]->as_dictionary_value();
+  EXPECT_EQ(*counter.lookup_str("ph"), "C");
+  EXPECT_EQ(*counter.lookup_dict("args")->lookup_int("in_use"), 1024);
+}
+
+}  // namespace blender::chrome_trace::tests
@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_noise.hh"
+#include "BLI_virtual_array.hh"
+
+namespace blender::noise::tests {
+
+TEST(noise, BatchHashMatchesScalar)
+{
+  const int size = 1000;
+  Array<uint32_t> kx(size);
+  Array<uint32_t> ky(size);
+  Array<float3> keys(size);
+  for (const int i : IndexRange(size)) {
+    kx[i] = uint32_t(i) * 7919u;
+    ky[i] = uint32_t(size - i);
+    keys[i] = float3(float(i) * 0.1f, float(i) * -3.3f, 1.0f / float(i + 1));
+  }
+
+  Array<uint32_t> hashes(size);
+  hash(kx, ky, hashes);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(hashes[i], hash(kx[i], ky[i]));
+  }
+
+  hash_float(keys, hashes);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(hashes[i], hash_float(keys[i]));
+  }
+
+  /* Output aliasing the input is supported. */
+  hash(hashes, ky, hashes);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(hashes[i], hash(hash_float(keys[i]), ky[i]));
+  }
+
+  Array<float> values(size);
+  hash_float_to_float(keys, values);
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(values[i], hash_float_to_float(keys[i]));
+  }
+}
+
+TEST(noise, BatchHashToFloatMatchesScalar)
+{
+  const int size = 1000;
+  Array<int> ids(size);
+  for (const int i : IndexRange(size)) {
+    ids[i] = i * 3 - 500;
+  }
+  const int seed = 42;
+  const VArray<int> ids_varray = VArray<int>::ForSpan(ids);
+  const VArray<int> seed_varray = VArray<int>::ForSingle(seed, size);
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(64), memory, [](const int64_t i) { return i % 3 != 0; });
+
+  Array<float> values(size, -1.0f);
+  hash_to_float(mask, seed_varray, ids_varray, values);
+  Array<float3> vectors(size, float3(-1.0f));
+  hash_to_float3(mask, seed_varray, ids_varray, vectors);
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(values[i], -1.0f);
+      EXPECT_EQ(vectors[i], float3(-1.0f));
+      continue;
+    }
+    EXPECT_EQ(values[i], hash_to_float(seed, ids[i]));
+    EXPECT_EQ(vectors[i].x, hash_to_float(seed, ids[i], 0));
+    EXPECT_EQ(vectors[i].y, hash_to_float(seed, ids[i], 1));
+    EXPECT_EQ(vectors[i].z, hash_to_float(seed, ids[i], 2));
+  }
+}
+
+}  // namespace blender::noise::tests
@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * API to evaluate many frames of a scene faster than one frame after the other, for exporters,
+ * bakes and caches. When no part of the scene depends on the state of the previous frame, several
+ * frames are evaluated at the same time by independent dependency graphs. All these graphs share
+ * the same original data, and only their evaluated copies are separate.
+ *
+ * The graphs are private to the evaluation and never active, so nothing is written back to the
+ * original data. Frame change handlers are not called and the frame of the original scene does
+ * not change, so Python drivers and handlers which read the current scene frame see the same frame
+ * for all evaluated frames. Features which have to match the interactive frame changes, like
+ * motion paths, don't use this API.
+ */
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+
+#include "DEG_depsgraph.hh"
+
+struct Main;
+struct Scene;
+struct ViewLayer;
+
+namespace blender::deg::concurrent_frames {
+
+/**
+ * False when evaluating a frame depends on the evaluation of the previous frames, for example
+ * because of simulation zones, physics with point caches or a rigid body world. Such scenes can
+ * only be evaluated one frame after the other.
+ */
+bool is_supported(const Depsgraph &depsgraph);
+
+/**
+ * Evaluate all `frames`, and call `frame_fn` on the calling thread for every frame in the order
+ * of `frames`, with a dependency graph which contains the evaluated state of that frame.
+ *
+ * Up to `max_concurrent_frames` frames are evaluated at the same time, each by its own newly
+ * created dependency graph for the given scene, view layer and evaluation mode. `build_fn` builds
+ * the relations of every graph, e.g. with #DEG_graph_build_from_ids. When #is_supported is false
+ * for the built graph, all frames are evaluated one after the other by a single graph.
+ *
+ * `frame_fn` returns false to stop the evaluation of the remaining frames.
+ */
+void evaluate(Main *bmain,
+              Scene *scene,
+              ViewLayer *view_layer,
+              eEvaluationMode mode,
+              Span<float> frames,
+              int max_concurrent_frames,
+              FunctionRef<void(Depsgraph &depsgraph)> build_fn,
+              FunctionRef<bool(Depsgraph &depsgraph, float frame)> frame_fn);
+
+}  // namespace blender::deg::concurrent_frames
@@ -8,19 +8,25 @@
 
 #include "intern/builder/deg_builder.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "DNA_ID.h"
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
+#include "DNA_constraint_types.h"
 #include "DNA_layer_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_set.hh"
 #include "BLI_stack.h"
+#include "BLI_string.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_action.hh"
+#include "BKE_animsys.h"
+#include "BKE_armature.hh"
 #include "BKE_collection.hh"
 #include "BKE_lib_id.hh"
 
@@ -149,6 +155,91 @@ bool DepsgraphBuilder::check_pchan_has_bbone_segments(const Object *object, cons
   return check_pchan_has_bbone_segments(object, pchan);
 }
 
+Vector<int> DepsgraphBuilder::get_batched_pose_channels(const Object *object)
+{
+  BLI_assert(object->type == OB_ARMATURE);
+  const bArmature *armature = static_cast<const bArmature *>(object->data);
+  const bPose *pose = object->pose;
+  if ((armature->flag & ARM_BATCH_POSE_EVAL) == 0 || pose == nullptr) {
+    return {};
+  }
+
+  /* Bones whose evaluation depends on more than their parent and their own animation. */
+  Set<const bPoseChannel *> excluded;
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &pose->chanbase) {
+    LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+      const bPoseChannel *rootchan = nullptr;
+      if (con->type == CONSTRAINT_TYPE_KINEMATIC) {
+        rootchan = BKE_armature_ik_solver_find_root(
+            pchan, static_cast<bKinematicConstraint *>(con->data));
+      }
+      else if (con->type == CONSTRAINT_TYPE_SPLINEIK) {
+        rootchan = BKE_armature_splineik_solver_find_root(
+            pchan, static_cast<bSplineIKConstraint *>(con->data));
+      }
+      else {
+        continue;
+      }
+      /* The solver writes to the whole chain. Without a known root, exclude all parents. */
+      for (const bPoseChannel *chain = pchan; chain != nullptr; chain = chain->parent) {
+        excluded.add(chain);
+        if (chain == rootchan) {
+          break;
+        }
+      }
+    }
+  }
+  /* Drivers can read other bones of the same pose, which would create cycles with the batch. */
+  const auto exclude_driven_bones = [&](const AnimData *adt, const char *prefix) {
+    if (adt == nullptr) {
+      return;
+    }
+    LISTBASE_FOREACH (const FCurve *, fcu, &adt->drivers) {
+      char bone_name[MAXBONENAME];
+      if (fcu->rna_path &&
+          BLI_str_quoted_substr(fcu->rna_path, prefix, bone_name, sizeof(bone_name)))
+      {
+        if (const bPoseChannel *pchan = BKE_pose_channel_find_name(pose, bone_name)) {
+          excluded.add(pchan);
+        }
+      }
+    }
+  };
+  exclude_driven_bones(object->adt, "pose.bones[");
+  exclude_driven_bones(armature->adt, "bones[");
+
+  struct BatchedChannel {
+    int index;
+    int depth;
+  };
+  Vector<BatchedChannel> batched;
+  int pchan_index = 0;
+  LISTBASE_FOREACH (const bPoseChannel *, pchan, &pose->chanbase) {
+    int depth = 0;
+    const bPoseChannel *chain = pchan;
+    for (; chain != nullptr; chain = chain->parent, depth++) {
+      if (chain->constraints.first != nullptr || excluded.contains(chain)) {
+        break;
+      }
+    }
+    if (chain == nullptr) {
+      batched.append({pchan_index, depth});
+    }
+    pchan_index++;
+  }
+
+  /* The order of pose channels doesn't necessarily follow the hierarchy. */
+  std::stable_sort(
+      batched.begin(), batched.end(), [](const BatchedChannel &a, const BatchedChannel &b) {
+        return a.depth < b.depth;
+      });
+  Vector<int> indices(batched.size());
+  for (const int i : batched.index_range()) {
+    indices[i] = batched[i].index;
+  }
+  return indices;
+}
+
 const char *DepsgraphBuilder::get_rna_path_relative_to_scene_camera(const Scene *scene,
                                                                     const PointerRNA &target_prop,
                                                                     const char *rna_path)
@@ -181,6 +272,9 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
   deg_graph_flush_visibility_flags(graph);
   deg_graph_remove_unused_noops(graph);
 
+  /* Data that animation paths were resolved to might be reallocated after relations changed. */
+  BKE_animsys_binding_cache_invalidate_all();
+
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
   for (IDNode *id_node : graph->id_nodes) {
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "BLI_vector.hh"
+
 struct Base;
 struct ID;
 struct Main;
@@ -35,6 +37,14 @@ class DepsgraphBuilder {
   virtual bool check_pchan_has_bbone_segments(const Object *object, const bPoseChannel *pchan);
   virtual bool check_pchan_has_bbone_segments(const Object *object, const char *bone_name);
 
+  /**
+   * Indices of the pose channels that are evaluated together by the #POSE_BONES_BATCH operation
+   * of an armature with #ARM_BATCH_POSE_EVAL, ordered so that parents come before children.
+   * These are bones without constraints, IK chains or drivers, whose parents are batched too.
+   * Their own operations are still created as no-ops, so relations to them keep working.
+   */
+  Vector<int> get_batched_pose_channels(const Object *object);
+
   /**
    * If `target_prop` + `rna_path` uses indirection via the `scene.camera` pointer, returns
    * the sub-string of `rna_path` relative to the camera; otherwise returns nullptr.
@@ -15,9 +15,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -410,6 +412,10 @@ void DepsgraphNodeBuilder::begin_build()
     if (op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) {
       needs_update_operations_.append_as(op_node);
     }
+    if (op_node->eval_time_estimate != 0.0f) {
+      saved_eval_time_operations_.append_as(op_node);
+      saved_eval_time_estimates_.append(op_node->eval_time_estimate);
+    }
   }
 
   /* Make sure graph has no nodes left from previous state. */
@@ -428,41 +434,27 @@ void DepsgraphNodeBuilder::begin_build()
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
  * the code to access the builder's data more easily. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::cow_pointer_needs_update(const ID *id_pointer) const
 {
   if (id_pointer->orig_id == nullptr) {
-    /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
-     * owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    IDNode *id_node = find_id_node(id_pointer);
-    if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
-  }
-  else {
-    /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
-     * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
-     * of evaluated depsgraph are still valid pointers, they are freed later (typically during
-     * destruction of the builder itself). */
-    IDNode *id_node = find_id_node(id_pointer->orig_id);
-    if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
+    /* The user of `id_pointer` uses a non-cow ID, if that ID has an evaluated copy in current
+     * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+    const IDNode *id_node = graph_->find_id_node(id_pointer);
+    return id_node != nullptr && id_node->id_cow != nullptr;
   }
-  return IDWALK_RET_NOP;
+  /* The user of `id_pointer` uses an evaluated ID, if that evaluated copy is removed from current
+   * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+  /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
+   * of evaluated depsgraph are still valid pointers, they are freed later (typically during
+   * destruction of the builder itself). */
+  return graph_->find_id_node(id_pointer->orig_id) == nullptr;
 }
 
+struct CowPointersUpdateData {
+  const DepsgraphNodeBuilder *builder;
+  bool needs_update;
+};
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +467,12 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
-
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+  CowPointersUpdateData *data = static_cast<CowPointersUpdateData *>(cb_data->user_data);
+  if (data->builder->cow_pointer_needs_update(id)) {
+    data->needs_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -493,18 +487,18 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
+  const auto id_node_needs_update = [&](const IDNode *id_node) {
     if (id_node->previously_visible_components_mask == 0) {
       /* Newly added node/ID, no need to check it. */
-      continue;
+      return false;
     }
     if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
       /* Node/ID with no copy-on-eval data, no need to check it. */
-      continue;
+      return false;
     }
     if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
       /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
-      continue;
+      return false;
     }
     if ((id_node->id_cow->flag & ID_FLAG_EMBEDDED_DATA) != 0) {
       /* For now, we assume embedded data are managed by their owner IDs and do not need to be
@@ -521,13 +515,35 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
        * completely new different pointer, and the existing copy-on-eval of the old master
        * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
        */
-      continue;
+      return false;
     }
+    CowPointersUpdateData data = {this, false};
     BKE_library_foreach_ID_link(nullptr,
                                 id_node->id_cow,
                                 deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
+                                &data,
                                 IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+    return data.needs_update;
+  };
+
+  /* The checks only read the graph and the evaluated copies, so they run in parallel. The IDs are
+   * tagged in the order of the ID nodes afterwards, so the result does not depend on the
+   * scheduling of the threads. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<bool> needs_update(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      needs_update[i] = id_node_needs_update(id_nodes[i]);
+    }
+  });
+  for (const int64_t i : id_nodes.index_range()) {
+    if (needs_update[i]) {
+      graph_id_tag_update(bmain_,
+                          graph_,
+                          id_nodes[i]->id_orig,
+                          ID_RECALC_SYNC_TO_EVAL,
+                          DEG_UPDATE_SOURCE_RELATIONS);
+    }
   }
 }
 
@@ -555,10 +571,22 @@ void DepsgraphNodeBuilder::tag_previously_tagged_nodes()
   }
 }
 
+void DepsgraphNodeBuilder::restore_eval_time_estimates()
+{
+  for (const int i : saved_eval_time_operations_.index_range()) {
+    OperationNode *operation_node = find_operation_node(saved_eval_time_operations_[i]);
+    if (operation_node == nullptr) {
+      continue;
+    }
+    operation_node->eval_time_estimate = saved_eval_time_estimates_[i];
+  }
+}
+
 void DepsgraphNodeBuilder::end_build()
 {
   graph_->light_linking_cache.end_build(*graph_->scene);
   tag_previously_tagged_nodes();
+  restore_eval_time_estimates();
   update_invalid_cow_pointers();
 }
 
@@ -90,10 +90,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void end_build();
 
   /**
-   * `id_cow_self` is the user of `id_pointer`,
-   * see also `LibraryIDLinkCallbackData` struct definition.
+   * Whether the evaluated ID which uses `id_pointer` needs to be copied again, because the
+   * evaluated copy of the pointed ID was created or removed by this build.
+   * See also `LibraryIDLinkCallbackData` struct definition.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool cow_pointer_needs_update(const ID *id_pointer) const;
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
@@ -298,6 +299,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   Vector<PersistentOperationKey> saved_entry_tags_;
   Vector<PersistentOperationKey> needs_update_operations_;
 
+  /* Evaluation time estimates of the operations from the previous state of the dependency graph,
+   * so that the evaluation scheduling does not have to learn them again after every rebuild. */
+  Vector<PersistentOperationKey> saved_eval_time_operations_;
+  Vector<float> saved_eval_time_estimates_;
+
   struct BuilderWalkUserData {
     DepsgraphNodeBuilder *builder;
   };
@@ -311,6 +317,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
                               void *user_data);
 
   void tag_previously_tagged_nodes();
+  void restore_eval_time_estimates();
   /**
    * Check for IDs that need to be flushed (copy-on-eval-updated)
    * because the depsgraph itself created or removed some of their evaluated dependencies.
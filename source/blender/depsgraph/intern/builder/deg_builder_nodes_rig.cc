@@ -15,6 +15,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
@@ -207,6 +208,19 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
       OperationCode::POSE_DONE,
       [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
   op_node->set_as_exit();
+  /* Bones evaluated together by a single operation, to avoid scheduling overhead. */
+  const Vector<int> batched_pchans = get_batched_pose_channels(object);
+  Array<bool> pchan_is_batched(BLI_listbase_count(&object->pose->chanbase), false);
+  pchan_is_batched.as_mutable_span().fill_indices(batched_pchans.as_span(), true);
+  if (!batched_pchans.is_empty()) {
+    add_operation_node(&object->id,
+                       NodeType::EVAL_POSE,
+                       OperationCode::POSE_BONES_BATCH,
+                       [scene_cow, object_cow, batched_pchans](::Depsgraph *depsgraph) {
+                         BKE_pose_eval_bone_batch(
+                             depsgraph, scene_cow, object_cow, batched_pchans);
+                       });
+  }
   /* Bones. */
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
@@ -215,24 +229,37 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
     op_node->set_as_entry();
 
-    add_operation_node(&object->id,
-                       NodeType::BONE,
-                       pchan->name,
-                       OperationCode::BONE_POSE_PARENT,
-                       [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
-                         BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
-                       });
+    if (pchan_is_batched[pchan_index]) {
+      /* Evaluated by the batch, the no-ops keep relations to the bone working. */
+      add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_POSE_PARENT);
+    }
+    else {
+      add_operation_node(&object->id,
+                         NodeType::BONE,
+                         pchan->name,
+                         OperationCode::BONE_POSE_PARENT,
+                         [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
+                           BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
+                         });
+    }
 
     /* NOTE: Dedicated noop for easier relationship construction. */
     add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
 
-    op_node = add_operation_node(&object->id,
-                                 NodeType::BONE,
-                                 pchan->name,
-                                 OperationCode::BONE_DONE,
-                                 [object_cow, pchan_index](::Depsgraph *depsgraph) {
-                                   BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
-                                 });
+    if (pchan_is_batched[pchan_index]) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    }
+    else {
+      op_node = add_operation_node(&object->id,
+                                   NodeType::BONE,
+                                   pchan->name,
+                                   OperationCode::BONE_DONE,
+                                   [object_cow, pchan_index](::Depsgraph *depsgraph) {
+                                     BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                                   });
+    }
 
     /* B-Bone shape computation - the real last step if present. */
     if (check_pchan_has_bbone(object, pchan)) {
@@ -18,8 +18,10 @@
 #include "DNA_modifier_types.h"
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -3470,8 +3472,25 @@ void DepsgraphRelationBuilder::build_vfont(VFont *vfont)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  /* The relations of each ID only depend on the nodes and relations of that ID which exist before
+   * this step, so they are found in parallel. They are added in the order of the ID nodes, so that
+   * the resulting graph does not depend on the scheduling of the threads. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<Vector<OperationRelationDesc>> id_relations(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      find_copy_on_write_relations(*id_nodes[i], id_relations[i]);
+    }
+  });
+  for (const Span<OperationRelationDesc> relations : id_relations) {
+    add_operation_relations(relations);
+  }
+}
+
+void DepsgraphRelationBuilder::add_operation_relations(const Span<OperationRelationDesc> relations)
+{
+  for (const OperationRelationDesc &relation : relations) {
+    graph_->add_new_relation(relation.from, relation.to, relation.description, relation.flags);
   }
 }
 
@@ -3513,7 +3532,15 @@ void DepsgraphRelationBuilder::build_nested_shapekey(ID *owner, Key *key)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
 {
-  ID *id_orig = id_node->id_orig;
+  Vector<OperationRelationDesc> relations;
+  find_copy_on_write_relations(*id_node, relations);
+  add_operation_relations(relations);
+}
+
+void DepsgraphRelationBuilder::find_copy_on_write_relations(
+    const IDNode &id_node, Vector<OperationRelationDesc> &r_relations) const
+{
+  ID *id_orig = id_node.id_orig;
 
   const ID_Type id_type = GS(id_orig->name);
 
@@ -3526,10 +3553,9 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
   // add_relation(time_source_key, copy_on_write_key, "Fluxgate capacitor hack");
   /* Resat of code is using rather low level trickery, so need to get some
    * explicit pointers. */
-  Node *node_cow = find_node(copy_on_write_key);
-  OperationNode *op_cow = node_cow->get_exit_operation();
+  OperationNode *op_cow = find_node(copy_on_write_key);
   /* Plug any other components to this one. */
-  for (ComponentNode *comp_node : id_node->components.values()) {
+  for (ComponentNode *comp_node : id_node.components.values()) {
     if (comp_node->type == NodeType::COPY_ON_EVAL) {
       /* Copy-on-eval component never depends on itself. */
       continue;
@@ -3575,8 +3601,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
-      rel->flag |= rel_flag;
+      r_relations.append({op_cow, op_entry, "Copy-on-Eval Dependency", rel_flag});
     }
     /* All dangling operations should also be executed after copy-on-evaluation. */
     for (OperationNode *op_node : comp_node->operations_map->values()) {
@@ -3584,8 +3609,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-        rel->flag |= rel_flag;
+        r_relations.append({op_cow, op_node, "Copy-on-Eval Dependency", rel_flag});
       }
       else {
         bool has_same_comp_dependency = false;
@@ -3600,8 +3624,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
-          rel->flag |= rel_flag;
+          r_relations.append({op_cow, op_node, "Copy-on-Eval Dependency", rel_flag});
         }
       }
     }
@@ -3622,8 +3645,9 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
       if (deg_eval_copy_is_needed(object_data_id)) {
         OperationKey data_copy_on_write_key(
             object_data_id, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+        if (OperationNode *op_data_cow = get_node(data_copy_on_write_key)) {
+          r_relations.append({op_data_cow, op_cow, "Eval Order", RELATION_FLAG_GODMODE});
+        }
       }
     }
     else {
@@ -74,6 +74,7 @@ struct ComponentNode;
 struct DepsNodeHandle;
 struct Depsgraph;
 class DepsgraphBuilderCache;
+struct IDDriverGroups;
 struct IDNode;
 struct Node;
 struct OperationNode;
@@ -81,6 +82,15 @@ struct Relation;
 struct RootPChanMap;
 struct TimeSourceNode;
 
+/* Relation between two operations which is found before it is added to the graph. This allows to
+ * find the relations of multiple IDs in parallel, and to add them in a deterministic order. */
+struct OperationRelationDesc {
+  OperationNode *from;
+  OperationNode *to;
+  const char *description;
+  int flags;
+};
+
 class DepsgraphRelationBuilder : public DepsgraphBuilder {
  public:
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
@@ -278,8 +288,13 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   virtual void build_copy_on_write_relations();
   virtual void build_copy_on_write_relations(IDNode *id_node);
+  void find_copy_on_write_relations(const IDNode &id_node,
+                                    Vector<OperationRelationDesc> &r_relations) const;
+  void add_operation_relations(Span<OperationRelationDesc> relations);
   virtual void build_driver_relations();
   virtual void build_driver_relations(IDNode *id_node);
+  unique_ptr<IDDriverGroups> find_driver_groups(const IDNode &id_node) const;
+  void build_driver_serialization_relations(const IDDriverGroups &id_driver_groups);
 
   template<typename KeyType> OperationNode *find_operation_node(const KeyType &key);
 
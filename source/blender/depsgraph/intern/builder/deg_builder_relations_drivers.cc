@@ -11,8 +11,11 @@
 #include "intern/builder/deg_builder_relations_drivers.h"
 
 #include <cstring>
+#include <memory>
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 
 #include "DNA_anim_types.h"
 
@@ -138,50 +141,81 @@ static bool is_reachable(const Node *const from, const Node *const to)
 
 /* **** DepsgraphRelationBuilder functions **** */
 
-void DepsgraphRelationBuilder::build_driver_relations()
-{
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_driver_relations(id_node);
-  }
-}
-
-void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
+/* Gather the drivers of the ID which can write to the same memory. This resolves the RNA paths of
+ * all drivers and looks up their operation nodes by name, which is most of the work of building
+ * these relations. It only reads original data and the graph, so it can run for multiple IDs in
+ * parallel. */
+unique_ptr<IDDriverGroups> DepsgraphRelationBuilder::find_driver_groups(
+    const IDNode &id_node) const
 {
-  /* Add relations between drivers that write to the same datablock.
-   *
-   * This prevents threading issues when two separate RNA properties write to
-   * the same memory address. For example:
-   * - Drivers on individual array elements, as the animation system will write
-   *   the whole array back to RNA even when changing individual array value.
-   * - Drivers on RNA properties that map to a single bit flag. Changing the RNA
-   *   value will write the entire int containing the bit, in a non-thread-safe
-   *   way.
-   */
-  ID *id_orig = id_node->id_orig;
+  ID *id_orig = id_node.id_orig;
   AnimData *adt = BKE_animdata_from_id(id_orig);
   if (adt == nullptr) {
-    return;
+    return nullptr;
   }
 
-  /* Mapping from RNA prefix -> set of driver descriptors: */
-  Map<string, Vector<DriverDescriptor>> driver_groups;
-
-  PointerRNA id_ptr = RNA_id_pointer_create(id_orig);
+  std::unique_ptr<IDDriverGroups> id_driver_groups = std::make_unique<IDDriverGroups>();
+  id_driver_groups->id_ptr = RNA_id_pointer_create(id_orig);
 
   LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
     if (fcu->rna_path == nullptr) {
       continue;
     }
 
-    DriverDescriptor driver_desc(&id_ptr, fcu);
+    DriverDescriptor driver_desc(&id_driver_groups->id_ptr, fcu);
     if (!driver_desc.driver_relations_needed()) {
       continue;
     }
+    driver_desc.operation_node = get_node(driver_desc.depsgraph_key());
 
-    driver_groups.lookup_or_add_default_as(driver_desc.rna_prefix).append(driver_desc);
+    id_driver_groups->driver_groups.lookup_or_add_default_as(driver_desc.rna_prefix)
+        .append(driver_desc);
   }
+  return id_driver_groups;
+}
 
-  for (Span<DriverDescriptor> prefix_group : driver_groups.values()) {
+void DepsgraphRelationBuilder::build_driver_relations()
+{
+  /* Drivers are gathered in parallel, but the relations are added in the order of the ID nodes,
+   * so that the resulting graph does not depend on the scheduling of the threads.
+   *
+   * The cycle checks stay serial: a relation added for one ID can create a path between the
+   * drivers of another ID, so checking IDs independently could create dependency cycles. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<std::unique_ptr<IDDriverGroups>> id_driver_groups(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      id_driver_groups[i] = find_driver_groups(*id_nodes[i]);
+    }
+  });
+  for (const std::unique_ptr<IDDriverGroups> &driver_groups : id_driver_groups) {
+    if (driver_groups) {
+      build_driver_serialization_relations(*driver_groups);
+    }
+  }
+}
+
+void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
+{
+  if (std::unique_ptr<IDDriverGroups> id_driver_groups = find_driver_groups(*id_node)) {
+    build_driver_serialization_relations(*id_driver_groups);
+  }
+}
+
+void DepsgraphRelationBuilder::build_driver_serialization_relations(
+    const IDDriverGroups &id_driver_groups)
+{
+  /* Add relations between drivers that write to the same datablock.
+   *
+   * This prevents threading issues when two separate RNA properties write to
+   * the same memory address. For example:
+   * - Drivers on individual array elements, as the animation system will write
+   *   the whole array back to RNA even when changing individual array value.
+   * - Drivers on RNA properties that map to a single bit flag. Changing the RNA
+   *   value will write the entire int containing the bit, in a non-thread-safe
+   *   way.
+   */
+  for (Span<DriverDescriptor> prefix_group : id_driver_groups.driver_groups.values()) {
     /* For each node in the driver group, try to connect it to another node
      * in the same group without creating any cycles. */
     int num_drivers = prefix_group.size();
@@ -191,13 +225,13 @@ void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
     }
     for (int from_index = 0; from_index < num_drivers; ++from_index) {
       const DriverDescriptor &driver_from = prefix_group[from_index];
-      Node *op_from = get_node(driver_from.depsgraph_key());
+      Node *op_from = driver_from.operation_node;
 
       /* Start by trying the next node in the group. */
       for (int to_offset = 1; to_offset < num_drivers; ++to_offset) {
         const int to_index = (from_index + to_offset) % num_drivers;
         const DriverDescriptor &driver_to = prefix_group[to_index];
-        Node *op_to = get_node(driver_to.depsgraph_key());
+        Node *op_to = driver_to.operation_node;
 
         /* Duplicate drivers can exist (see #78615), but cannot be distinguished by OperationKey
          * and thus have the same depsgraph node. Relations between those drivers should not be
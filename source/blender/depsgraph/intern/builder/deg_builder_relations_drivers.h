@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "BLI_map.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
 
 #include "RNA_types.hh"
 
@@ -36,6 +38,9 @@ class DriverDescriptor {
   StringRef rna_prefix;
   StringRef rna_suffix;
 
+  /** Node which evaluates the driver, looked up while gathering the drivers. */
+  OperationNode *operation_node = nullptr;
+
  public:
   DriverDescriptor(PointerRNA *id_ptr, FCurve *fcu);
 
@@ -59,4 +64,13 @@ class DriverDescriptor {
   bool resolve_rna();
 };
 
+/* Drivers of an ID which need relations between each other, grouped by their RNA prefix. */
+struct IDDriverGroups {
+  /* Pointer to the ID, referenced by the driver descriptors. */
+  PointerRNA id_ptr;
+  Map<std::string, Vector<DriverDescriptor>> driver_groups;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("IDDriverGroups");
+};
+
 }  // namespace blender::deg
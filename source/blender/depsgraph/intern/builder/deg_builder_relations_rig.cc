@@ -16,6 +16,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_utildefines.h"
 
@@ -369,8 +370,17 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
     ComponentKey local_transform_key(&object->id, NodeType::TRANSFORM);
     add_relation(local_transform_key, pose_key, "Local Transforms");
   }
+  /* Bones evaluated by a single batch operation, in the order of their hierarchy. */
+  const Vector<int> batched_pchans = get_batched_pose_channels(object);
+  Array<bool> pchan_is_batched(BLI_listbase_count(&object->pose->chanbase), false);
+  pchan_is_batched.as_mutable_span().fill_indices(batched_pchans.as_span(), true);
+  OperationKey pose_batch_key(&object->id, NodeType::EVAL_POSE, OperationCode::POSE_BONES_BATCH);
+  if (!batched_pchans.is_empty()) {
+    add_relation(pose_init_key, pose_batch_key, "Pose Init -> Bones Batch");
+  }
   /* Links between operations for each bone. */
-  LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+  int pchan_index = 0;
+  LISTBASE_FOREACH_INDEX (bPoseChannel *, pchan, &object->pose->chanbase, pchan_index) {
     const BuilderStack::ScopedEntry stack_entry = stack_.trace(*pchan);
 
     build_idproperties(pchan->prop);
@@ -384,10 +394,17 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
     pchan->flag &= ~POSE_DONE;
     /* Pose init to bone local. */
     add_relation(pose_init_key, bone_local_key, "Pose Init - Bone Local", RELATION_FLAG_GODMODE);
-    /* Local to pose parenting operation. */
-    add_relation(bone_local_key, bone_pose_key, "Bone Local - Bone Pose");
+    if (pchan_is_batched[pchan_index]) {
+      /* The whole parent chain is in the batch, which evaluates it in order. */
+      add_relation(bone_local_key, pose_batch_key, "Bone Local -> Bones Batch");
+      add_relation(pose_batch_key, bone_pose_key, "Bones Batch -> Bone Pose");
+    }
+    else {
+      /* Local to pose parenting operation. */
+      add_relation(bone_local_key, bone_pose_key, "Bone Local - Bone Pose");
+    }
     /* Parent relation. */
-    if (pchan->parent != nullptr) {
+    if (pchan->parent != nullptr && !pchan_is_batched[pchan_index]) {
       OperationCode parent_key_opcode;
       /* NOTE: this difference in handling allows us to prevent lockups
        * while ensuring correct poses for separate chains. */
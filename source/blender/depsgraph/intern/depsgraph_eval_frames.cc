@@ -0,0 +1,177 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "BLI_listbase.h"
+#include "BLI_memory_utils.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_node.hh"
+
+#include "DNA_modifier_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_frames.hh"
+
+#ifdef WITH_PYTHON
+#  include "BPY_extern.hh"
+#endif
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_id.hh"
+
+namespace blender::deg::concurrent_frames {
+
+static bool node_tree_has_simulation(const bNodeTree &ntree)
+{
+  for (const bNestedNodeRef &ref : ntree.nested_node_refs_span()) {
+    const bNode *node = ntree.find_nested_node(ref.id);
+    if (node != nullptr && node->type == GEO_NODE_SIMULATION_OUTPUT) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool object_depends_on_previous_frame(const Object &object)
+{
+  LISTBASE_FOREACH (const ModifierData *, md, &object.modifiers) {
+    switch (ModifierType(md->type)) {
+      case eModifierType_Cloth:
+      case eModifierType_Collision:
+      case eModifierType_DynamicPaint:
+      case eModifierType_Fluid:
+      case eModifierType_ParticleSystem:
+      case eModifierType_Softbody:
+      case eModifierType_Surface:
+        /* These keep the state of the previous frame or step a point cache. */
+        return true;
+      case eModifierType_Nodes: {
+        const NodesModifierData *nmd = reinterpret_cast<const NodesModifierData *>(md);
+        if (nmd->node_group != nullptr && node_tree_has_simulation(*nmd->node_group)) {
+          return true;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+bool is_supported(const ::Depsgraph &depsgraph)
+{
+  const deg::Depsgraph &deg_graph = reinterpret_cast<const deg::Depsgraph &>(depsgraph);
+  for (const IDNode *id_node : deg_graph.id_nodes) {
+    const ID *id = id_node->id_orig;
+    switch (GS(id->name)) {
+      case ID_SCE:
+        if (reinterpret_cast<const Scene *>(id)->rigidbody_world != nullptr) {
+          return false;
+        }
+        break;
+      case ID_OB:
+        if (object_depends_on_previous_frame(*reinterpret_cast<const Object *>(id))) {
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+static void evaluate_sequentially(
+    ::Depsgraph &depsgraph,
+    const Span<float> frames,
+    const FunctionRef<bool(::Depsgraph &depsgraph, float frame)> frame_fn)
+{
+  for (const float frame : frames) {
+    DEG_evaluate_on_framechange(&depsgraph, frame);
+    if (!frame_fn(depsgraph, frame)) {
+      break;
+    }
+  }
+}
+
+void evaluate(Main *bmain,
+              Scene *scene,
+              ViewLayer *view_layer,
+              const eEvaluationMode mode,
+              const Span<float> frames,
+              const int max_concurrent_frames,
+              const FunctionRef<void(::Depsgraph &depsgraph)> build_fn,
+              const FunctionRef<bool(::Depsgraph &depsgraph, float frame)> frame_fn)
+{
+  if (frames.is_empty()) {
+    return;
+  }
+  auto new_graph = [&]() {
+    ::Depsgraph *graph = DEG_graph_new(bmain, scene, view_layer, mode);
+    BLI_assert(!DEG_is_active(graph));
+    build_fn(*graph);
+    return graph;
+  };
+
+  Vector<::Depsgraph *> graphs = {new_graph()};
+  BLI_SCOPED_DEFER([&]() {
+    for (::Depsgraph *graph : graphs) {
+      DEG_graph_free(graph);
+    }
+  });
+
+  const int graphs_num = std::min<int>(max_concurrent_frames, frames.size());
+  if (graphs_num <= 1 || !is_supported(*graphs[0])) {
+    evaluate_sequentially(*graphs[0], frames, frame_fn);
+    return;
+  }
+  for ([[maybe_unused]] const int i : IndexRange(1, graphs_num - 1)) {
+    graphs.append(new_graph());
+  }
+
+  /* Frames are evaluated in batches of one frame per graph, the next batch can only start once
+   * the previous frames have been passed to the caller. */
+  for (int64_t batch_start = 0; batch_start < frames.size(); batch_start += graphs_num) {
+    const Span<float> batch_frames = frames.slice(
+        batch_start, std::min<int64_t>(graphs_num, frames.size() - batch_start));
+
+#ifdef WITH_PYTHON
+    /* Python drivers may be evaluated from any of the threads. */
+    BPy_BEGIN_ALLOW_THREADS;
+#endif
+    threading::parallel_for(batch_frames.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        /* Don't let the wait for the operations of this graph pick up the evaluation of another
+         * frame. */
+        threading::isolate_task(
+            [&]() { DEG_evaluate_on_framechange(graphs[i], batch_frames[i]); });
+      }
+    });
+#ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#endif
+
+    bool stop = false;
+    for (const int i : batch_frames.index_range()) {
+      if (!frame_fn(*graphs[i], batch_frames[i])) {
+        stop = true;
+        break;
+      }
+    }
+    if (stop) {
+      break;
+    }
+  }
+}
+
+}  // namespace blender::deg::concurrent_frames
@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "tests/blendfile_loading_base_test.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_matrix_types.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_string.h"
+#include "BLI_vector.hh"
+
+#include "BKE_action.hh"
+#include "BKE_anim_data.hh"
+#include "BKE_fcurve.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.hh"
+#include "BKE_object.hh"
+
+#include "BLO_readfile.hh"
+
+#include "DNA_anim_types.h"
+#include "DNA_curve_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_frames.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "MEM_guardedalloc.h"
+
+namespace blender::deg::concurrent_frames::tests {
+
+/** Evaluated state of all objects at one frame. */
+struct FrameState {
+  float frame;
+  Vector<float4x4> transforms;
+  Vector<float3> positions;
+};
+
+class ConcurrentFramesTest : public BlendfileLoadingBaseTest {
+ protected:
+  /** Animate the X location of all objects linearly from 0 at frame 1 to 10 at frame 11. */
+  void animate_objects()
+  {
+    Main *bmain = bfile->main;
+    bAction *action = BKE_action_add(bmain, "Action");
+    FCurve *fcu = BKE_fcurve_create();
+    fcu->rna_path = BLI_strdup("location");
+    fcu->array_index = 0;
+    fcu->totvert = 2;
+    fcu->bezt = MEM_cnew_array<BezTriple>(fcu->totvert, __func__);
+    for (const int i : IndexRange(fcu->totvert)) {
+      BezTriple &bezt = fcu->bezt[i];
+      bezt.vec[1][0] = 1.0f + i * 10.0f;
+      bezt.vec[1][1] = i * 10.0f;
+      bezt.ipo = BEZT_IPO_LIN;
+      bezt.h1 = bezt.h2 = HD_AUTO_ANIM;
+    }
+    BKE_fcurve_handles_recalc(fcu);
+    BLI_addtail(&action->curves, fcu);
+
+    LISTBASE_FOREACH (Object *, object, &bmain->objects) {
+      AnimData *adt = BKE_animdata_ensure_id(&object->id);
+      adt->action = action;
+      id_us_plus(&action->id);
+    }
+  }
+
+  FrameState get_state(Depsgraph &graph, const float frame)
+  {
+    FrameState state;
+    state.frame = frame;
+    LISTBASE_FOREACH (Object *, object, &bfile->main->objects) {
+      const Object *object_eval = DEG_get_evaluated_object(&graph, object);
+      state.transforms.append(object_eval->object_to_world());
+      if (const Mesh *mesh = BKE_object_get_evaluated_mesh(object_eval)) {
+        state.positions.extend(mesh->vert_positions());
+      }
+    }
+    return state;
+  }
+};
+
+static void expect_states_equal(const Span<FrameState> a, const Span<FrameState> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_EQ(a[i].frame, b[i].frame);
+    EXPECT_EQ(a[i].transforms, b[i].transforms);
+    EXPECT_EQ(a[i].positions, b[i].positions);
+  }
+}
+
+TEST_F(ConcurrentFramesTest, MatchesSequentialEvaluation)
+{
+  if (!blendfile_load("modifier_stack" SEP_STR "array_test.blend")) {
+    return;
+  }
+  animate_objects();
+  depsgraph_create(DAG_EVAL_RENDER);
+  ASSERT_TRUE(is_supported(*depsgraph));
+
+  const Vector<float> frames = {1.0f, 2.0f, 3.5f, 7.0f, 5.0f, 11.0f, 12.0f};
+
+  Vector<FrameState> sequential_states;
+  for (const float frame : frames) {
+    DEG_evaluate_on_framechange(depsgraph, frame);
+    sequential_states.append(get_state(*depsgraph, frame));
+  }
+  /* The animation has to be visible in the evaluated state for the comparison to be useful. */
+  EXPECT_NE(sequential_states.first().transforms, sequential_states.last().transforms);
+
+  for (const int max_concurrent_frames : {1, 3, 16}) {
+    Vector<FrameState> concurrent_states;
+    evaluate(
+        bfile->main,
+        bfile->curscene,
+        bfile->cur_view_layer,
+        DAG_EVAL_RENDER,
+        frames,
+        max_concurrent_frames,
+        [&](Depsgraph &graph) {
+          EXPECT_FALSE(DEG_is_active(&graph));
+          DEG_graph_build_from_view_layer(&graph);
+        },
+        [&](Depsgraph &graph, const float frame) {
+          concurrent_states.append(get_state(graph, frame));
+          return true;
+        });
+    expect_states_equal(concurrent_states, sequential_states);
+  }
+}
+
+TEST_F(ConcurrentFramesTest, StopEvaluation)
+{
+  if (!blendfile_load("modifier_stack" SEP_STR "array_test.blend")) {
+    return;
+  }
+
+  const Vector<float> frames = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Vector<float> evaluated_frames;
+  evaluate(
+      bfile->main,
+      bfile->curscene,
+      bfile->cur_view_layer,
+      DAG_EVAL_RENDER,
+      frames,
+      4,
+      [&](Depsgraph &graph) { DEG_graph_build_from_view_layer(&graph); },
+      [&](Depsgraph & /*graph*/, const float frame) {
+        evaluated_frames.append(frame);
+        return frame < 3.0f;
+      });
+  EXPECT_EQ(evaluated_frames.as_span(), Span<float>({1.0f, 2.0f, 3.0f}));
+}
+
+}  // namespace blender::deg::concurrent_frames::tests
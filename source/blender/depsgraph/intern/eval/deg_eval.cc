@@ -10,12 +10,16 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
@@ -38,6 +42,7 @@
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/eval/deg_eval_flush.h"
 #include "intern/eval/deg_eval_stats.h"
+#include "intern/eval/deg_eval_trace.h"
 #include "intern/eval/deg_eval_visibility.h"
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -80,25 +85,40 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Only allocated when the timeline trace is enabled. */
+  std::unique_ptr<EvalTrace> trace;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
 };
 
+/* Weight of the last evaluation time in the moving average of the operation evaluation time. */
+constexpr float eval_time_estimate_factor = 0.25f;
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. The time is always measured, since it is needed for scheduling. */
+  const double start_time = BLI_time_now_seconds();
+  operation_node->evaluate(depsgraph);
+  const double end_time = BLI_time_now_seconds();
+  const float eval_time = float(end_time - start_time);
+  if (state->trace) {
+    state->trace->record(*operation_node, start_time, end_time);
+  }
   if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    operation_node->stats.current_time += eval_time;
+  }
+  /* Only the thread evaluating the operation accesses the estimate. */
+  if (operation_node->eval_time_estimate == 0.0f) {
+    operation_node->eval_time_estimate = eval_time;
   }
   else {
-    operation_node->evaluate(depsgraph);
+    operation_node->eval_time_estimate += (eval_time - operation_node->eval_time_estimate) *
+                                          eval_time_estimate_factor;
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -108,19 +128,51 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
+bool critical_path_is_longer(const OperationNode *a, const OperationNode *b)
+{
+  return a->critical_path_time > b->critical_path_time;
+}
+
+/* Push the operations to the pool, the ones with the longest critical path first. Idle threads
+ * steal the oldest tasks of other threads first, so they pick up the longest chains. */
+void schedule_operations_in_pool(TaskPool *pool, MutableSpan<OperationNode *> nodes)
+{
+  std::stable_sort(nodes.begin(), nodes.end(), critical_path_is_longer);
+  for (OperationNode *node : nodes) {
+    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  }
+}
+
 void deg_task_run_func(TaskPool *pool, void *taskdata)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
+  /* Instead of pushing every operation which became ready to the pool, the task continues with
+   * the ready child on the longest critical path itself. This way long chains of dependent
+   * operations (like a character rig followed by a heavy modifier stack) are not delayed behind
+   * many small independent operations, without any shared queue that threads have to lock. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  Vector<OperationNode *, 16> ready_children;
+  while (true) {
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    ready_children.clear();
+    schedule_children(
+        state, operation_node, [&](OperationNode *node) { ready_children.append(node); });
+    if (ready_children.is_empty()) {
+      break;
+    }
+    int64_t next_index = 0;
+    for (const int64_t i : ready_children.index_range().drop_front(1)) {
+      if (critical_path_is_longer(ready_children[i], ready_children[next_index])) {
+        next_index = i;
+      }
+    }
+    operation_node = ready_children[next_index];
+    ready_children.remove_and_reorder(next_index);
+    schedule_operations_in_pool(pool, ready_children);
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -173,6 +225,71 @@ void calculate_pending_parents_for_node(const DepsgraphEvalState *state, Operati
   }
 }
 
+bool need_evaluate_operation(const DepsgraphEvalState *state, OperationNode *node)
+{
+  return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && check_operation_node_visible(state, node);
+}
+
+/* Estimated cost of an operation on its own. Operations which were not evaluated yet get a small
+ * cost, so that long chains are still preferred without any history. */
+float operation_eval_time_estimate(const OperationNode *node)
+{
+  if (node->is_noop()) {
+    return 0.0f;
+  }
+  return node->eval_time_estimate + 1e-6f;
+}
+
+/* Calculate #OperationNode::critical_path_time of all operations which are to be evaluated, by
+ * visiting their children first in a depth-first traversal. Cyclic relations are ignored, which
+ * makes the remaining graph acyclic. */
+void calculate_critical_path_times(const DepsgraphEvalState *state)
+{
+  constexpr float unvisited = -1.0f;
+  for (OperationNode *node : state->graph->operations) {
+    node->critical_path_time = unvisited;
+  }
+
+  struct StackEntry {
+    OperationNode *node;
+    int64_t next_link;
+  };
+  Vector<StackEntry, 64> stack;
+  for (OperationNode *root : state->graph->operations) {
+    if (root->critical_path_time != unvisited || !need_evaluate_operation(state, root)) {
+      continue;
+    }
+    /* Operations on the stack are marked as visited with a zero time, so that they are not
+     * visited again. */
+    root->critical_path_time = 0.0f;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      StackEntry &entry = stack.last();
+      OperationNode *node = entry.node;
+      if (entry.next_link < node->outlinks.size()) {
+        const Relation *rel = node->outlinks[entry.next_link++];
+        OperationNode *child = reinterpret_cast<OperationNode *>(rel->to);
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->critical_path_time == unvisited &&
+            need_evaluate_operation(state, child))
+        {
+          child->critical_path_time = 0.0f;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      float children_time = 0.0f;
+      for (const Relation *rel : node->outlinks) {
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+          const OperationNode *child = reinterpret_cast<const OperationNode *>(rel->to);
+          children_time = std::max(children_time, child->critical_path_time);
+        }
+      }
+      node->critical_path_time = operation_eval_time_estimate(node) + children_time;
+      stack.remove_last();
+    }
+  }
+}
+
 void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
 {
   if (!state->need_update_pending_parents) {
@@ -316,10 +433,13 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
   state->stage = stage;
 
   calculate_pending_parents_if_needed(state);
+  if (stage == EvaluationStage::THREADED_EVALUATION) {
+    calculate_critical_path_times(state);
+  }
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  Vector<OperationNode *> ready_operations;
+  schedule_graph(state, [&](OperationNode *node) { ready_operations.append(node); });
+  schedule_operations_in_pool(task_pool, ready_operations);
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -402,6 +522,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  if (deg_eval_trace_is_enabled()) {
+    state.trace = std::make_unique<EvalTrace>();
+  }
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -456,6 +579,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.trace) {
+    state.trace->write(*graph);
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
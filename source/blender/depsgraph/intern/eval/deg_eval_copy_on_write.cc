@@ -33,6 +33,7 @@
 #include "BKE_layer.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mesh_types.hh"
+#include "BKE_node.hh"
 #include "BKE_object_types.hh"
 #include "BKE_scene.hh"
 
@@ -47,6 +48,7 @@
 #include "DNA_gpencil_legacy_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
+#include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_particle_types.h"
 #include "DNA_rigidbody_types.h"
@@ -64,7 +66,6 @@
 #  include "DNA_linestyle_types.h"
 #  include "DNA_material_types.h"
 #  include "DNA_meta_types.h"
-#  include "DNA_node_types.h"
 #  include "DNA_texture_types.h"
 #  include "DNA_world_types.h"
 #endif
@@ -855,6 +856,291 @@ ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
   return id_cow;
 }
 
+/* Node flags which only affect the user interface, and are updated in place instead of copying
+ * the whole node tree again. */
+constexpr int ntree_ui_only_node_flags = NODE_SELECT | NODE_ACTIVE;
+
+bool ntree_strings_match(const char *str_orig, const char *str_cow)
+{
+  if (str_orig == nullptr || str_cow == nullptr) {
+    return str_orig == str_cow;
+  }
+  return STREQ(str_orig, str_cow);
+}
+
+/* Compare a socket default value of the given type. */
+bool ntree_socket_value_matches(const Depsgraph *depsgraph,
+                                const eNodeSocketDatatype type,
+                                const void *value_orig,
+                                const void *value_cow)
+{
+  if (value_orig == nullptr || value_cow == nullptr) {
+    return value_orig == value_cow;
+  }
+  switch (type) {
+    case SOCK_OBJECT:
+    case SOCK_IMAGE:
+    case SOCK_COLLECTION:
+    case SOCK_TEXTURE:
+    case SOCK_MATERIAL: {
+      /* All these values only contain an ID pointer, which is remapped in the evaluated copy. */
+      const ID *id_orig = *static_cast<ID *const *>(value_orig);
+      const ID *id_cow = *static_cast<ID *const *>(value_cow);
+      return (id_orig == nullptr) ? id_cow == nullptr : depsgraph->get_cow_id(id_orig) == id_cow;
+    }
+    default: {
+      const size_t size = MEM_allocN_len(value_orig);
+      return size == MEM_allocN_len(value_cow) && memcmp(value_orig, value_cow, size) == 0;
+    }
+  }
+}
+
+bool ntree_socket_value_can_update_in_place(const bNodeSocket &socket)
+{
+  return ELEM(socket.type,
+              SOCK_FLOAT,
+              SOCK_INT,
+              SOCK_BOOLEAN,
+              SOCK_VECTOR,
+              SOCK_RGBA,
+              SOCK_ROTATION,
+              SOCK_STRING) &&
+         socket.default_value != nullptr;
+}
+
+bool ntree_sockets_match(const Depsgraph *depsgraph,
+                         const ListBase &sockets_orig,
+                         const ListBase &sockets_cow)
+{
+  const bNodeSocket *socket_orig = static_cast<const bNodeSocket *>(sockets_orig.first);
+  const bNodeSocket *socket_cow = static_cast<const bNodeSocket *>(sockets_cow.first);
+  for (; socket_orig && socket_cow; socket_orig = socket_orig->next, socket_cow = socket_cow->next)
+  {
+    if (socket_orig->type != socket_cow->type || socket_orig->flag != socket_cow->flag ||
+        !STREQ(socket_orig->identifier, socket_cow->identifier))
+    {
+      return false;
+    }
+    if (ntree_socket_value_can_update_in_place(*socket_orig)) {
+      if (socket_cow->default_value == nullptr ||
+          MEM_allocN_len(socket_orig->default_value) != MEM_allocN_len(socket_cow->default_value))
+      {
+        return false;
+      }
+    }
+    else if (!ntree_socket_value_matches(depsgraph,
+                                         eNodeSocketDatatype(socket_orig->type),
+                                         socket_orig->default_value,
+                                         socket_cow->default_value))
+    {
+      return false;
+    }
+  }
+  return socket_orig == nullptr && socket_cow == nullptr;
+}
+
+bool ntree_node_matches(const Depsgraph *depsgraph, const bNode &node_orig, const bNode &node_cow)
+{
+  if (node_orig.identifier != node_cow.identifier || node_orig.typeinfo != node_cow.typeinfo ||
+      node_orig.custom1 != node_cow.custom1 || node_orig.custom2 != node_cow.custom2 ||
+      node_orig.custom3 != node_cow.custom3 || node_orig.custom4 != node_cow.custom4 ||
+      (node_orig.flag & ~ntree_ui_only_node_flags) !=
+          (node_cow.flag & ~ntree_ui_only_node_flags) ||
+      !STREQ(node_orig.name, node_cow.name))
+  {
+    return false;
+  }
+  if ((node_orig.parent ? node_orig.parent->identifier : -1) !=
+      (node_cow.parent ? node_cow.parent->identifier : -1))
+  {
+    return false;
+  }
+  if ((node_orig.id ? depsgraph->get_cow_id(node_orig.id) : nullptr) != node_cow.id) {
+    return false;
+  }
+  if (node_orig.storage != nullptr || node_cow.storage != nullptr) {
+    /* Storage with owned data is copied with a custom function, and is never equal byte by byte
+     * to the original. */
+    if (node_orig.storage == nullptr || node_cow.storage == nullptr) {
+      return false;
+    }
+    const size_t size = MEM_allocN_len(node_orig.storage);
+    if (size != MEM_allocN_len(node_cow.storage) ||
+        memcmp(node_orig.storage, node_cow.storage, size) != 0)
+    {
+      return false;
+    }
+  }
+  if ((node_orig.prop != nullptr || node_cow.prop != nullptr) &&
+      !IDP_EqualsProperties(node_orig.prop, node_cow.prop))
+  {
+    return false;
+  }
+  return ntree_sockets_match(depsgraph, node_orig.inputs, node_cow.inputs) &&
+         ntree_sockets_match(depsgraph, node_orig.outputs, node_cow.outputs);
+}
+
+bool ntree_link_matches(const bNodeLink &link_orig, const bNodeLink &link_cow)
+{
+  return link_orig.flag == link_cow.flag &&
+         link_orig.multi_input_sort_id == link_cow.multi_input_sort_id &&
+         link_orig.fromnode->identifier == link_cow.fromnode->identifier &&
+         link_orig.tonode->identifier == link_cow.tonode->identifier &&
+         STREQ(link_orig.fromsock->identifier, link_cow.fromsock->identifier) &&
+         STREQ(link_orig.tosock->identifier, link_cow.tosock->identifier);
+}
+
+bool ntree_interface_items_match(const Depsgraph *depsgraph,
+                                 const bNodeTreeInterfaceItem &item_orig,
+                                 const bNodeTreeInterfaceItem &item_cow)
+{
+  if (item_orig.item_type != item_cow.item_type) {
+    return false;
+  }
+  switch (eNodeTreeInterfaceItemType(item_orig.item_type)) {
+    case NODE_INTERFACE_SOCKET: {
+      const auto &socket_orig = reinterpret_cast<const bNodeTreeInterfaceSocket &>(item_orig);
+      const auto &socket_cow = reinterpret_cast<const bNodeTreeInterfaceSocket &>(item_cow);
+      if (socket_orig.flag != socket_cow.flag ||
+          socket_orig.attribute_domain != socket_cow.attribute_domain ||
+          socket_orig.default_input != socket_cow.default_input ||
+          !ntree_strings_match(socket_orig.identifier, socket_cow.identifier) ||
+          !ntree_strings_match(socket_orig.socket_type, socket_cow.socket_type) ||
+          !ntree_strings_match(socket_orig.name, socket_cow.name) ||
+          !ntree_strings_match(socket_orig.description, socket_cow.description) ||
+          !ntree_strings_match(socket_orig.default_attribute_name,
+                               socket_cow.default_attribute_name))
+      {
+        return false;
+      }
+      /* Unregistered socket types have unknown data, so they are never considered equal. */
+      const bke::bNodeSocketType *typeinfo = socket_orig.socket_typeinfo();
+      if (typeinfo == nullptr ||
+          !ntree_socket_value_matches(
+              depsgraph, typeinfo->type, socket_orig.socket_data, socket_cow.socket_data))
+      {
+        return false;
+      }
+      return IDP_EqualsProperties(socket_orig.properties, socket_cow.properties);
+    }
+    case NODE_INTERFACE_PANEL: {
+      const auto &panel_orig = reinterpret_cast<const bNodeTreeInterfacePanel &>(item_orig);
+      const auto &panel_cow = reinterpret_cast<const bNodeTreeInterfacePanel &>(item_cow);
+      if (panel_orig.flag != panel_cow.flag || panel_orig.identifier != panel_cow.identifier ||
+          panel_orig.items_num != panel_cow.items_num ||
+          !ntree_strings_match(panel_orig.name, panel_cow.name) ||
+          !ntree_strings_match(panel_orig.description, panel_cow.description))
+      {
+        return false;
+      }
+      for (const int i : panel_orig.items().index_range()) {
+        if (!ntree_interface_items_match(
+                depsgraph, *panel_orig.items()[i], *panel_cow.items()[i]))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ntree_nested_node_refs_match(const bNodeTree &ntree_orig, const bNodeTree &ntree_cow)
+{
+  if (ntree_orig.nested_node_refs_num != ntree_cow.nested_node_refs_num) {
+    return false;
+  }
+  for (const int i : IndexRange(ntree_orig.nested_node_refs_num)) {
+    const bNestedNodeRef &ref_orig = ntree_orig.nested_node_refs[i];
+    const bNestedNodeRef &ref_cow = ntree_cow.nested_node_refs[i];
+    if (ref_orig.id != ref_cow.id || ref_orig.path.node_id != ref_cow.path.node_id ||
+        ref_orig.path.id_in_node != ref_cow.path.id_in_node)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Check whether the evaluated node tree only differs from the original in values that can be
+ * updated in place, which is the common case of tweaking an input value of a node.
+ *
+ * ID properties which point to other IDs are remapped in the evaluated copy and never compare
+ * equal, so trees with such properties are always copied.
+ */
+bool ntree_can_update_eval_copy_in_place(const Depsgraph *depsgraph,
+                                         const bNodeTree &ntree_orig,
+                                         const bNodeTree &ntree_cow)
+{
+  if (ntree_orig.type != ntree_cow.type || ntree_orig.flag != ntree_cow.flag) {
+    return false;
+  }
+  if (!ntree_nested_node_refs_match(ntree_orig, ntree_cow)) {
+    return false;
+  }
+  if (!IDP_EqualsProperties(ntree_orig.id.properties, ntree_cow.id.properties)) {
+    return false;
+  }
+  if (!ntree_interface_items_match(depsgraph,
+                                   ntree_orig.tree_interface.root_panel.item,
+                                   ntree_cow.tree_interface.root_panel.item))
+  {
+    return false;
+  }
+  /* Changes of the action or drivers are not detected, so animated trees are always copied. */
+  if (ntree_orig.adt != nullptr || ntree_cow.adt != nullptr) {
+    return false;
+  }
+  const bNode *node_orig = static_cast<const bNode *>(ntree_orig.nodes.first);
+  const bNode *node_cow = static_cast<const bNode *>(ntree_cow.nodes.first);
+  for (; node_orig && node_cow; node_orig = node_orig->next, node_cow = node_cow->next) {
+    if (!ntree_node_matches(depsgraph, *node_orig, *node_cow)) {
+      return false;
+    }
+  }
+  if (node_orig != nullptr || node_cow != nullptr) {
+    return false;
+  }
+  const bNodeLink *link_orig = static_cast<const bNodeLink *>(ntree_orig.links.first);
+  const bNodeLink *link_cow = static_cast<const bNodeLink *>(ntree_cow.links.first);
+  for (; link_orig && link_cow; link_orig = link_orig->next, link_cow = link_cow->next) {
+    if (!ntree_link_matches(*link_orig, *link_cow)) {
+      return false;
+    }
+  }
+  return link_orig == nullptr && link_cow == nullptr;
+}
+
+void ntree_update_sockets_in_place(const ListBase &sockets_orig, ListBase &sockets_cow)
+{
+  const bNodeSocket *socket_orig = static_cast<const bNodeSocket *>(sockets_orig.first);
+  bNodeSocket *socket_cow = static_cast<bNodeSocket *>(sockets_cow.first);
+  for (; socket_orig; socket_orig = socket_orig->next, socket_cow = socket_cow->next) {
+    if (ntree_socket_value_can_update_in_place(*socket_orig)) {
+      memcpy(socket_cow->default_value,
+             socket_orig->default_value,
+             MEM_allocN_len(socket_orig->default_value));
+    }
+  }
+}
+
+/* Copy the values which may differ according to #ntree_can_update_eval_copy_in_place. */
+void ntree_update_eval_copy_in_place(const bNodeTree &ntree_orig, bNodeTree &ntree_cow)
+{
+  const bNode *node_orig = static_cast<const bNode *>(ntree_orig.nodes.first);
+  bNode *node_cow = static_cast<bNode *>(ntree_cow.nodes.first);
+  for (; node_orig; node_orig = node_orig->next, node_cow = node_cow->next) {
+    node_cow->flag = (node_cow->flag & ~ntree_ui_only_node_flags) |
+                     (node_orig->flag & ntree_ui_only_node_flags);
+    ntree_update_sockets_in_place(node_orig->inputs, node_cow->inputs);
+    ntree_update_sockets_in_place(node_orig->outputs, node_cow->outputs);
+  }
+  /* The cached geometry nodes lazy-function graph contains the values of unlinked inputs, it is
+   * rebuilt by the geometry preprocess operation which runs after the copy-on-evaluation. */
+}
+
 }  // namespace
 
 ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
@@ -898,6 +1184,18 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
     }
   }
 
+  /* Changing input values of nodes is very common, and copying the entire node tree again for
+   * that is expensive for large trees. This is also done when the copy was explicitly tagged,
+   * because every node tree change tags the copy, and only matching trees are updated. */
+  if (check_datablock_expanded(id_cow) && GS(id_orig->name) == ID_NT) {
+    const bNodeTree &ntree_orig = *reinterpret_cast<const bNodeTree *>(id_orig);
+    bNodeTree &ntree_cow = *reinterpret_cast<bNodeTree *>(id_cow);
+    if (ntree_can_update_eval_copy_in_place(depsgraph, ntree_orig, ntree_cow)) {
+      ntree_update_eval_copy_in_place(ntree_orig, ntree_cow);
+      return id_cow;
+    }
+  }
+
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_eval_copy_datablock(id_cow);
@@ -0,0 +1,87 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_trace.h"
+
+#include <cstdio>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include "BLI_path_utils.hh"
+#include "BLI_string.h"
+
+#include "BKE_appdir.hh"
+#include "BKE_global.hh"
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+bool deg_eval_trace_is_enabled()
+{
+  return (G.debug & G_DEBUG_DEPSGRAPH_TRACE) != 0;
+}
+
+void EvalTrace::record(const OperationNode &operation_node,
+                       const double start_time,
+                       const double end_time)
+{
+  events_.append({&operation_node, start_time, end_time});
+}
+
+void EvalTrace::write(const Depsgraph &graph)
+{
+  std::optional<double> first_start;
+  events_.foreach_event([&](const int /*thread_index*/, const Event &event) {
+    if (!first_start || event.start_time < *first_start) {
+      first_start = event.start_time;
+    }
+  });
+  if (!first_start) {
+    return;
+  }
+
+  chrome_trace::TraceWriter writer;
+  events_.foreach_event([&](const int thread_index, const Event &event) {
+    const OperationNode &operation_node = *event.operation_node;
+    const ComponentNode &component_node = *operation_node.owner;
+    const IDNode &id_node = *component_node.owner;
+    io::serialize::DictionaryValue &args = writer.add_complete_event(
+        operation_node.identifier(),
+        nodeTypeAsString(component_node.type),
+        thread_index,
+        (event.start_time - *first_start) * 1e6,
+        (event.end_time - event.start_time) * 1e6);
+    args.append_str("id", id_node.name);
+    args.append_str("component", component_node.identifier());
+  });
+
+  /* The graph name contains the view layer name, which may not be valid in a file name. */
+  char filename[FILE_MAXFILE];
+  STRNCPY(filename,
+          fmt::format("depsgraph_trace_{}_frame_{}_update_{}.json",
+                      graph.debug.name.empty() ? "main" : graph.debug.name,
+                      graph.frame,
+                      graph.update_count)
+              .c_str());
+  BLI_path_make_safe_filename(filename);
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), BKE_tempdir_base(), filename);
+
+  if (!writer.write(filepath)) {
+    fprintf(stderr, "Depsgraph trace could not be written to \"%s\"\n", filepath);
+    return;
+  }
+  printf("Depsgraph trace written to \"%s\"\n", filepath);
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,47 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Timeline trace of the dependency graph evaluation, enabled with `--debug-depsgraph-trace`.
+ *
+ * Unlike the accumulated timing statistics, the trace keeps the start and end time and the thread
+ * of every evaluated operation, which shows how well the evaluation uses the available threads.
+ * A trace file is written for every evaluation in the Chrome trace event format.
+ */
+
+#pragma once
+
+#include "BLI_chrome_trace.hh"
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct OperationNode;
+
+/* True when `--debug-depsgraph-trace` was passed on the command line. */
+bool deg_eval_trace_is_enabled();
+
+class EvalTrace {
+ public:
+  /* Record the evaluation of an operation. Thread-safe, the event is stored in a thread-local
+   * buffer. */
+  void record(const OperationNode &operation_node, double start_time, double end_time);
+
+  /* Write all recorded events to a file in the temporary directory, named after the graph and the
+   * evaluated frame. Has to be called while the operation nodes still exist. */
+  void write(const Depsgraph &graph);
+
+ private:
+  struct Event {
+    const OperationNode *operation_node;
+    double start_time;
+    double end_time;
+  };
+
+  chrome_trace::ThreadEventBuffers<Event> events_;
+};
+
+}  // namespace blender::deg
@@ -116,6 +116,8 @@ enum class OperationCode {
   /* IK/Spline Solvers */
   POSE_IK_SOLVER,
   POSE_SPLINE_IK_SOLVER,
+  /* Evaluation of all bones that don't need their own operations, see #ARM_BATCH_POSE_EVAL. */
+  POSE_BONES_BATCH,
 
   /* Bone. ---------------------------------------------------------------- */
   /* Bone local transforms - entry point */
@@ -289,6 +291,14 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Moving average of the evaluation time of this operation in seconds. Kept across evaluations
+   * and graph rebuilds, and used to estimate which operations are on the critical path. */
+  float eval_time_estimate;
+  /* Estimated time in seconds needed to evaluate this operation followed by the longest chain of
+   * operations which depend on it. Ready operations with the longest critical path are evaluated
+   * first. */
+  float critical_path_time;
+
   DEG_DEPSNODE_DECLARE;
 };
 
@@ -96,4 +96,7 @@ void ANIM_OT_driver_button_edit(wmOperatorType *ot);
 void ANIM_OT_copy_driver_button(wmOperatorType *ot);
 void ANIM_OT_paste_driver_button(wmOperatorType *ot);
 
+/** List drivers in the file that need Python to be evaluated. */
+void ANIM_OT_drivers_report_python(wmOperatorType *ot);
+
 /** \} */
@@ -16,12 +16,15 @@
 #include "BLI_utildefines.h"
 
 #include "DNA_anim_types.h"
+#include "DNA_node_types.h"
 #include "DNA_texture_types.h"
 
 #include "BKE_anim_data.hh"
 #include "BKE_context.hh"
 #include "BKE_fcurve.hh"
 #include "BKE_fcurve_driver.h"
+#include "BKE_main.hh"
+#include "BKE_node.hh"
 #include "BKE_report.hh"
 
 #include "DEG_depsgraph.hh"
@@ -1242,3 +1245,67 @@ void ANIM_OT_paste_driver_button(wmOperatorType *ot)
 }
 
 /* ************************************************** */
+
+/* Report Python Drivers Operator ------------------------ */
+
+static int report_python_drivers_exec(bContext *C, wmOperator *op)
+{
+  Main *bmain = CTX_data_main(C);
+  int drivers_num = 0;
+  int python_drivers_num = 0;
+
+  BKE_animdata_main_cb(bmain, [&](ID *id, AnimData *adt) {
+    /* The drivers of embedded node trees are passed with the ID which owns the node tree. */
+    const bNodeTree *ntree = (adt != BKE_animdata_from_id(id)) ?
+                                 blender::bke::node_tree_from_id(id) :
+                                 nullptr;
+    LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
+      ChannelDriver *driver = fcu->driver;
+      if (driver == nullptr) {
+        continue;
+      }
+      drivers_num++;
+      /* Only scripted expressions the simple expression evaluator can't handle need Python,
+       * and with it the global interpreter lock that serializes their evaluation. */
+      if (driver->type != DRIVER_TYPE_PYTHON || BKE_driver_has_simple_expression(driver)) {
+        continue;
+      }
+      python_drivers_num++;
+      BKE_reportf(op->reports,
+                  RPT_INFO,
+                  "%s%s%s: %s[%d]: %s",
+                  id->name + 2,
+                  ntree ? " > " : "",
+                  ntree ? ntree->id.name + 2 : "",
+                  fcu->rna_path ? fcu->rna_path : "",
+                  fcu->array_index,
+                  driver->expression);
+    }
+  });
+
+  BKE_reportf(op->reports,
+              python_drivers_num ? RPT_WARNING : RPT_INFO,
+              "%d of %d drivers require Python to be evaluated",
+              python_drivers_num,
+              drivers_num);
+
+  return OPERATOR_FINISHED;
+}
+
+void ANIM_OT_drivers_report_python(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Report Python Drivers";
+  ot->idname = "ANIM_OT_drivers_report_python";
+  ot->description =
+      "List the scripted drivers that can't use the simple expression evaluator and need "
+      "Python, which prevents them from being evaluated in parallel";
+
+  /* callbacks */
+  ot->exec = report_python_drivers_exec;
+
+  /* flags */
+  ot->flag = OPTYPE_REGISTER;
+}
+
+/* ************************************************** */
@@ -302,6 +302,14 @@ class LazyFunction {
    */
   virtual void destruct_storage(void *storage) const;
 
+  /**
+   * Prepare the storage created in #init_storage for another evaluation with new inputs. This
+   * allows evaluating the same function many times in a row without setting up the storage
+   * every time. Functions that keep track of state in their storage have to implement this to
+   * support being reset.
+   */
+  virtual void reset_storage(void *storage) const;
+
   /**
    * Calls `fn` with the input indices that the given `output_index` may depend on. By default
    * every output depends on every input.
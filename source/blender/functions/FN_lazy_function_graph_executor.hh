@@ -130,6 +130,7 @@ class GraphExecutor : public LazyFunction {
 
   void *init_storage(LinearAllocator<> &allocator) const override;
   void destruct_storage(void *storage) const override;
+  void reset_storage(void *storage) const override;
 
   std::string input_name(int index) const override;
   std::string output_name(int index) const override;
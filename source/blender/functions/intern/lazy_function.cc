@@ -38,6 +38,12 @@ void LazyFunction::destruct_storage(void *storage) const
   UNUSED_VARS_NDEBUG(storage);
 }
 
+void LazyFunction::reset_storage(void *storage) const
+{
+  BLI_assert(storage == nullptr);
+  UNUSED_VARS_NDEBUG(storage);
+}
+
 void LazyFunction::possible_output_dependencies(const int /*output_index*/,
                                                 const FunctionRef<void(Span<int>)> fn) const
 {
@@ -322,7 +322,8 @@ class Executor {
     std::optional<destruct_ptr<LocalUserData>> local_user_data;
   };
   std::unique_ptr<threading::EnumerableThreadSpecific<ThreadLocalStorage>> thread_locals_;
-  LinearAllocator<> main_allocator_;
+  /** Is replaced when the executor is reset, to free the memory of the previous evaluation. */
+  std::unique_ptr<LinearAllocator<>> main_allocator_ = std::make_unique<LinearAllocator<>>();
   /**
    * Set to false when the first execution ends.
    */
@@ -353,13 +354,25 @@ class Executor {
     if (TaskPool *task_pool = task_pool_.load()) {
       BLI_task_pool_free(task_pool);
     }
-    threading::parallel_for(node_states_.index_range(), 1024, [&](const IndexRange range) {
-      for (const int node_index : range) {
-        const Node &node = *self_.graph_.nodes()[node_index];
-        NodeState &node_state = *node_states_[node_index];
-        this->destruct_node_state(node, node_state);
-      }
-    });
+    this->destruct_node_states();
+  }
+
+  /**
+   * Prepare for another evaluation of the graph with new inputs, as if the executor was just
+   * constructed. The task pool is kept, but all memory of the previous evaluation is freed so
+   * that repeated evaluations don't accumulate memory.
+   */
+  void reset()
+  {
+    BLI_assert(params_ == nullptr);
+    this->destruct_node_states();
+    node_states_ = {};
+    loaded_inputs_ = {};
+    if (thread_locals_) {
+      thread_locals_ = std::make_unique<threading::EnumerableThreadSpecific<ThreadLocalStorage>>();
+    }
+    main_allocator_ = std::make_unique<LinearAllocator<>>();
+    is_first_execution_ = true;
   }
 
   /**
@@ -461,6 +474,17 @@ class Executor {
     });
   }
 
+  void destruct_node_states()
+  {
+    threading::parallel_for(node_states_.index_range(), 1024, [&](const IndexRange range) {
+      for (const int node_index : range) {
+        const Node &node = *self_.graph_.nodes()[node_index];
+        NodeState &node_state = *node_states_[node_index];
+        this->destruct_node_state(node, node_state);
+      }
+    });
+  }
+
   void destruct_node_state(const Node &node, NodeState &node_state)
   {
     if (node.is_function()) {
@@ -1296,7 +1320,7 @@ class Executor {
   LocalData get_local_data()
   {
     if (!this->use_multi_threading()) {
-      return {&main_allocator_, context_->local_user_data};
+      return {main_allocator_.get(), context_->local_user_data};
     }
     ThreadLocalStorage &local_storage = thread_locals_->local();
     if (!local_storage.local_user_data.has_value()) {
@@ -1536,6 +1560,11 @@ void GraphExecutor::destruct_storage(void *storage) const
   std::destroy_at(static_cast<Executor *>(storage));
 }
 
+void GraphExecutor::reset_storage(void *storage) const
+{
+  static_cast<Executor *>(storage)->reset();
+}
+
 std::string GraphExecutor::input_name(const int index) const
 {
   const lf::OutputSocket &socket = *graph_inputs_[index];
@@ -21,6 +21,15 @@
 #  include <type_traits>
 #endif
 
+#ifdef __cplusplus
+namespace blender::bke {
+struct AnimDataBindingCache;
+}  // namespace blender::bke
+using AnimDataBindingCacheHandle = blender::bke::AnimDataBindingCache;
+#else
+typedef struct AnimDataBindingCacheHandle AnimDataBindingCacheHandle;
+#endif
+
 /* ************************************************ */
 /* F-Curve DataTypes */
 
@@ -1200,6 +1209,11 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /**
+   * Runtime data, for depsgraph evaluation. RNA paths of the active action's F-Curves, resolved
+   * on the evaluated ID so that they don't have to be resolved again on every frame.
+   */
+  AnimDataBindingCacheHandle *binding_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
@@ -365,6 +365,11 @@ typedef enum eArmature_Flag {
   ARM_DS_EXPAND = (1 << 13),
   /** Other objects are used for visualizing various states (hack for efficient updates). */
   ARM_HAS_VIZ_DEPS = (1 << 14),
+  /**
+   * Evaluate bones without constraints, IK or drivers in a single dependency graph operation
+   * instead of separate operations per bone, to reduce the scheduling overhead of large rigs.
+   */
+  ARM_BATCH_POSE_EVAL = (1 << 15),
 } eArmature_Flag;
 
 /* armature->drawtype */
@@ -324,6 +324,15 @@ typedef struct Mesh {
    * Cached map from each vertex to the faces using it.
    */
   blender::GroupedSpan<int> vert_to_face_map() const;
+  /**
+   * Cached map from each vertex to the edges using it.
+   */
+  blender::GroupedSpan<int> vert_to_edge_map() const;
+  /**
+   * Cached map from each edge to the face corners using it. For each corner, the edge connects
+   * the corner's vertex and the vertex of the next corner in the face.
+   */
+  blender::GroupedSpan<int> edge_to_corner_map() const;
 
   /**
    * Cached information about loose edges, calculated lazily when necessary.
@@ -2306,6 +2306,15 @@ static void rna_def_armature(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Display Bone Colors", "Display bone colors");
   RNA_def_property_update(prop, 0, "rna_Armature_redraw_data");
 
+  prop = RNA_def_property(srna, "use_batched_pose_evaluation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", ARM_BATCH_POSE_EVAL);
+  RNA_def_property_ui_text(
+      prop,
+      "Batched Pose Evaluation",
+      "Evaluate bones without constraints, IK or drivers in a single operation, which reduces "
+      "the evaluation overhead of rigs with many bones");
+  RNA_def_property_update(prop, 0, "rna_Armature_dependency_update");
+
   prop = RNA_def_property(srna, "is_editmode", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_funcs(prop, "rna_Armature_is_editmode_get", nullptr);
   RNA_def_property_clear_flag(prop, PROP_EDITABLE);
@@ -0,0 +1,102 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ *
+ * Optional profiler for geometry nodes evaluation, enabled with `--debug-geometry-nodes-profile`.
+ *
+ * The execution times logged by #GeoTreeLogger are only meant for the node editor overlay. They
+ * are only gathered for trees that are visible in the UI and do not contain information about
+ * threads or memory. The profiler records every node execution on every thread instead, together
+ * with the change in allocated memory and the size of the input geometry. The events are written
+ * as a Chrome trace file when Blender exits, which can be inspected in `chrome://tracing` or
+ * Perfetto.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_string_ref.hh"
+
+#include "FN_lazy_function.hh"
+
+#include "NOD_geometry_nodes_log.hh"
+
+struct bNode;
+
+namespace blender::nodes::geo_eval_profile {
+
+using geo_eval_log::TimePoint;
+
+struct NodeExecutionEvent {
+  std::string tree_name;
+  std::string node_name;
+  int node_id;
+  /** What kind of node was executed, e.g. "Node", "Group" or "Repeat Zone". */
+  const char *kind;
+  TimePoint start;
+  TimePoint end;
+  /**
+   * Highest total memory allocated with guarded-alloc while the node was executed. For group
+   * nodes and zones this includes the memory used by all nested nodes.
+   */
+  int64_t memory_peak;
+  /**
+   * Change of allocated memory during the execution of the node. This is approximate when other
+   * threads allocate memory at the same time.
+   */
+  int64_t memory_delta;
+  /** Number of points, vertices and instances in all geometry inputs of the node. */
+  int64_t input_geometry_size;
+};
+
+/** True when `--debug-geometry-nodes-profile` was passed on the command line. */
+bool is_enabled();
+
+/** Number of points, vertices and instances in the geometry, used as a cheap size metric. */
+int64_t geometry_size(const bke::GeometrySet &geometry);
+
+/** Thread-safe, the event is stored in a thread-local buffer. */
+void record_node_execution(NodeExecutionEvent event);
+
+/**
+ * Records a #NodeExecutionEvent for the lifetime of this object when profiling is enabled and
+ * does nothing otherwise. Has to be constructed before the node is executed, because geometry
+ * inputs are generally moved into the outputs by the node.
+ *
+ * The peak memory is tracked with the global guarded-alloc peak statistic, which is reset every
+ * time a profiled execution starts or ends. So the peak reported elsewhere (e.g. in the render
+ * statistics) is meaningless while profiling.
+ */
+class ScopedNodeExecution : NonCopyable, NonMovable {
+ private:
+  /** Null when profiling is disabled. */
+  const bNode *node_ = nullptr;
+  const char *kind_;
+  int64_t input_geometry_size_;
+  int64_t memory_before_;
+  /** Updated from other threads while this execution is running, see #PeakMemoryTracker. */
+  int64_t memory_peak_;
+  TimePoint start_;
+
+ public:
+  ScopedNodeExecution(const bNode &node,
+                      const char *kind,
+                      const lf::LazyFunction &fn,
+                      const lf::Params &params);
+  ~ScopedNodeExecution();
+};
+
+/**
+ * Write all recorded events in the Chrome trace event format.
+ * \return False if the file could not be written.
+ */
+bool write_chrome_trace(StringRefNull filepath);
+
+/** Write the trace to the temporary directory if anything was recorded and free all events. */
+void exit();
+
+}  // namespace blender::nodes::geo_eval_profile
@@ -137,6 +137,53 @@ static void node_gather_link_search_ops(GatherLinkSearchOpParams &params)
   }
 }
 
+/**
+ * Random float and vector values are generated in two passes. First, all hashes are computed
+ * with the batch hash functions, which is much faster than hashing element by element. Then the
+ * values are mapped to the requested range. The result is the same as computing everything at
+ * once for every element.
+ */
+template<typename T> class RandomRangeFunction : public mf::MultiFunction {
+ public:
+  RandomRangeFunction(const char *name)
+  {
+    mf::SignatureBuilder builder{name, signature_};
+    builder.single_input<T>("Min");
+    builder.single_input<T>("Max");
+    builder.single_input<int>("ID");
+    builder.single_input<int>("Seed");
+    builder.single_output<T>("Value");
+    this->set_signature(&signature_);
+  }
+
+  void call(const IndexMask &mask, mf::Params params, mf::Context /*context*/) const override
+  {
+    const VArray<T> &min_values = params.readonly_single_input<T>(0, "Min");
+    const VArray<T> &max_values = params.readonly_single_input<T>(1, "Max");
+    const VArray<int> &ids = params.readonly_single_input<int>(2, "ID");
+    const VArray<int> &seeds = params.readonly_single_input<int>(3, "Seed");
+    MutableSpan<T> values = params.uninitialized_single_output<T>(4, "Value");
+
+    if constexpr (std::is_same_v<T, float3>) {
+      noise::hash_to_float3(mask, seeds, ids, values);
+    }
+    else {
+      noise::hash_to_float(mask, seeds, ids, values);
+    }
+
+    devirtualize_varray2(min_values, max_values, [&](const auto mins, const auto maxs) {
+      mask.foreach_index_optimized<int64_t>([&](const int64_t i) {
+        const T min_value = mins[i];
+        const T max_value = maxs[i];
+        values[i] = values[i] * (max_value - min_value) + min_value;
+      });
+    });
+  }
+
+ private:
+  mf::Signature signature_;
+};
+
 static void node_build_multi_function(NodeMultiFunctionBuilder &builder)
 {
   const NodeRandomValue &storage = node_storage(builder.node());
@@ -144,26 +191,12 @@ static void node_build_multi_function(NodeMultiFunctionBuilder &builder)
 
   switch (data_type) {
     case CD_PROP_FLOAT3: {
-      static auto fn = mf::build::SI4_SO<float3, float3, int, int, float3>(
-          "Random Vector",
-          [](float3 min_value, float3 max_value, int id, int seed) -> float3 {
-            const float x = noise::hash_to_float(seed, id, 0);
-            const float y = noise::hash_to_float(seed, id, 1);
-            const float z = noise::hash_to_float(seed, id, 2);
-            return float3(x, y, z) * (max_value - min_value) + min_value;
-          },
-          mf::build::exec_presets::SomeSpanOrSingle<2>());
+      static const RandomRangeFunction<float3> fn("Random Vector");
       builder.set_matching_fn(fn);
       break;
     }
     case CD_PROP_FLOAT: {
-      static auto fn = mf::build::SI4_SO<float, float, int, int, float>(
-          "Random Float",
-          [](float min_value, float max_value, int id, int seed) -> float {
-            const float value = noise::hash_to_float(seed, id);
-            return value * (max_value - min_value) + min_value;
-          },
-          mf::build::exec_presets::SomeSpanOrSingle<2>());
+      static const RandomRangeFunction<float> fn("Random Float");
       builder.set_matching_fn(fn);
       break;
     }
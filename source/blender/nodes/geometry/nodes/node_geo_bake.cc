@@ -832,6 +832,7 @@ void draw_common_bake_settings(bContext *C, BakeDrawContext &ctx, uiLayout *layo
     uiItemR(subcol, &ctx.bake_rna, "frame_start", UI_ITEM_NONE, IFACE_("Start"), ICON_NONE);
     uiItemR(subcol, &ctx.bake_rna, "frame_end", UI_ITEM_NONE, IFACE_("End"), ICON_NONE);
   }
+  uiItemR(settings_col, &ctx.bake_rna, "use_compression", UI_ITEM_NONE, nullptr, ICON_NONE);
 }
 
 static void draw_bake_data_block_list_item(uiList * /*ui_list*/,
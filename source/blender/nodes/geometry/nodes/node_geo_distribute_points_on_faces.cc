@@ -113,40 +113,62 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<int> corner_verts = mesh.corner_verts();
   const Span<int3> corner_tris = mesh.corner_tris();
 
-  for (const int tri_i : corner_tris.index_range()) {
+  /* Every triangle uses its own random number generator, so the points of every triangle can be
+   * generated independently. The points are counted first, which allows writing them directly to
+   * their final location afterwards. That gives the same result as a serial evaluation. */
+  auto point_amount_for_tri = [&](const int tri_i, RandomNumberGenerator &rng) {
     const int3 &tri = corner_tris[tri_i];
-    const int v0_loop = tri[0];
-    const int v1_loop = tri[1];
-    const int v2_loop = tri[2];
-    const float3 &v0_pos = positions[corner_verts[v0_loop]];
-    const float3 &v1_pos = positions[corner_verts[v1_loop]];
-    const float3 &v2_pos = positions[corner_verts[v2_loop]];
-
     float corner_tri_density_factor = 1.0f;
     if (!density_factors.is_empty()) {
-      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
+      const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
+      const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
       corner_tri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) /
                                   3.0f;
     }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int corner_tri_seed = noise::hash(tri_i, seed);
-    RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-
-    const int point_amount = corner_tri_rng.round_probabilistic(area * base_density *
-                                                                corner_tri_density_factor);
+    const float area = area_tri_v3(positions[corner_verts[tri[0]]],
+                                   positions[corner_verts[tri[1]]],
+                                   positions[corner_verts[tri[2]]]);
+    return rng.round_probabilistic(area * base_density * corner_tri_density_factor);
+  };
 
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_tri_indices.append(tri_i);
+  Array<int> offsets_data(corner_tris.size() + 1);
+  threading::parallel_for(corner_tris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      RandomNumberGenerator corner_tri_rng(noise::hash(tri_i, seed));
+      offsets_data[tri_i] = point_amount_for_tri(tri_i, corner_tri_rng);
     }
-  }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(offsets_data);
+
+  BLI_assert(r_positions.is_empty());
+  r_positions.resize(offsets.total_size());
+  r_bary_coords.resize(offsets.total_size());
+  r_tri_indices.resize(offsets.total_size());
+
+  threading::parallel_for(corner_tris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      const IndexRange points = offsets[tri_i];
+      if (points.is_empty()) {
+        continue;
+      }
+      const int3 &tri = corner_tris[tri_i];
+      const float3 &v0_pos = positions[corner_verts[tri[0]]];
+      const float3 &v1_pos = positions[corner_verts[tri[1]]];
+      const float3 &v2_pos = positions[corner_verts[tri[2]]];
+
+      /* Recompute the amount to bring the generator into the same state as in the first pass. */
+      RandomNumberGenerator corner_tri_rng(noise::hash(tri_i, seed));
+      point_amount_for_tri(tri_i, corner_tri_rng);
+
+      for (const int point_i : points) {
+        const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[point_i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[point_i] = bary_coord;
+      }
+      r_tri_indices.as_mutable_span().slice(points).fill(tri_i);
+    }
+  });
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
@@ -206,26 +228,31 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const MutableSpan<bool> elimination_mask)
 {
   const Span<int3> corner_tris = mesh.corner_tris();
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 1024, [&](const IndexRange range) {
+    Array<float, 1024> hashes(range.size());
+    noise::hash_float_to_float(bary_coords.slice(range), hashes);
+
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const int3 &tri = corner_tris[tri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const int3 &tri = corner_tris[tri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
-    const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
-    const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
+      const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
+      const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
+      const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
 
-    const float probability = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                              v2_density_factor * bary_coord.z;
+      const float probability = v0_density_factor * bary_coord.x +
+                                v1_density_factor * bary_coord.y +
+                                v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probability) {
-      elimination_mask[i] = true;
+      if (hashes[i - range.start()] > probability) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
@@ -422,11 +449,9 @@ BLI_NOINLINE static void compute_attribute_outputs(const Mesh &mesh,
   }
 
   threading::parallel_for(bary_coords.index_range(), 1024, [&](const IndexRange range) {
-    for (const int i : range) {
-      const int tri_i = tri_indices[i];
-      const float3 &bary_coord = bary_coords[i];
-      ids.span[i] = noise::hash(noise::hash_float(bary_coord), tri_i);
-    }
+    const MutableSpan<uint32_t> hashes = ids.span.slice(range).cast<uint32_t>();
+    noise::hash_float(bary_coords.slice(range), hashes);
+    noise::hash(hashes, tri_indices.slice(range).cast<uint32_t>(), hashes);
   });
 
   if (normals) {
@@ -22,6 +22,7 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_profile.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -246,6 +247,8 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return this->anonymous_attribute_name_for_output(*user_data, i);
     };
 
+    const geo_eval_profile::ScopedNodeExecution profile_scope{node_, "Node", *this, params};
+
     GeoNodeExecParams geo_params{
         node_,
         params,
@@ -1158,6 +1161,7 @@ class LazyFunctionForGroupNode : public LazyFunction {
     GeoNodesLFLocalUserData group_local_user_data{group_user_data};
     lf::Context group_context{storage->group_storage, &group_user_data, &group_local_user_data};
 
+    const geo_eval_profile::ScopedNodeExecution profile_scope{group_node_, "Group", *this, params};
     ScopedComputeContextTimer timer(group_context);
     group_lazy_function_.execute(params, group_context);
   }
@@ -1483,6 +1487,8 @@ class LazyFunctionForSimulationZone : public LazyFunction {
     GeoNodesLFLocalUserData zone_local_user_data{zone_user_data};
     lf::Context zone_context{context.storage, &zone_user_data, &zone_local_user_data};
 
+    const geo_eval_profile::ScopedNodeExecution profile_scope{
+        sim_output_bnode_, "Simulation Zone", *this, params};
     ScopedComputeContextTimer timer(zone_context);
     fn_.execute(params, zone_context);
   }
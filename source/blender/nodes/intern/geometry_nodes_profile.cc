@@ -0,0 +1,231 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdio>
+#include <mutex>
+
+#include "BLI_chrome_trace.hh"
+#include "BLI_path_utils.hh"
+
+#include "BKE_appdir.hh"
+#include "BKE_curves.hh"
+#include "BKE_global.hh"
+#include "BKE_instances.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "NOD_geometry_nodes_profile.hh"
+
+namespace blender::nodes::geo_eval_profile {
+
+static chrome_trace::ThreadEventBuffers<NodeExecutionEvent> &get_events()
+{
+  static chrome_trace::ThreadEventBuffers<NodeExecutionEvent> events;
+  return events;
+}
+
+/**
+ * Guarded-alloc only has a single global peak statistic. To get the peak of every execution, the
+ * statistic is sampled and reset whenever a profiled execution starts or ends, and each sample is
+ * accumulated into the peaks of all executions that are running at that time. This also works
+ * for nested executions like group nodes and zones, and for executions on other threads.
+ */
+class PeakMemoryTracker {
+ private:
+  std::mutex mutex_;
+  Vector<int64_t *> running_peaks_;
+
+ public:
+  void begin(int64_t &r_peak)
+  {
+    std::lock_guard lock{mutex_};
+    this->accumulate_peak();
+    r_peak = int64_t(MEM_get_memory_in_use());
+    running_peaks_.append(&r_peak);
+  }
+
+  void end(int64_t &peak)
+  {
+    std::lock_guard lock{mutex_};
+    this->accumulate_peak();
+    running_peaks_.remove_first_occurrence_and_reorder(&peak);
+  }
+
+ private:
+  void accumulate_peak()
+  {
+    const int64_t peak = int64_t(MEM_get_peak_memory());
+    MEM_reset_peak_memory();
+    for (int64_t *running_peak : running_peaks_) {
+      *running_peak = std::max(*running_peak, peak);
+    }
+  }
+};
+
+static PeakMemoryTracker &get_peak_memory_tracker()
+{
+  static PeakMemoryTracker tracker;
+  return tracker;
+}
+
+bool is_enabled()
+{
+  return G.debug & G_DEBUG_GEOMETRY_NODES_PROFILE;
+}
+
+int64_t geometry_size(const bke::GeometrySet &geometry)
+{
+  int64_t size = 0;
+  if (const Mesh *mesh = geometry.get_mesh()) {
+    size += mesh->verts_num;
+  }
+  if (const Curves *curves = geometry.get_curves()) {
+    size += curves->geometry.point_num;
+  }
+  if (const PointCloud *pointcloud = geometry.get_pointcloud()) {
+    size += pointcloud->totpoint;
+  }
+  if (const bke::Instances *instances = geometry.get_instances()) {
+    size += instances->instances_num();
+  }
+  return size;
+}
+
+void record_node_execution(NodeExecutionEvent event)
+{
+  get_events().append(std::move(event));
+}
+
+static int64_t compute_input_geometry_size(const lf::LazyFunction &fn, const lf::Params &params)
+{
+  const CPPType &geometry_type = CPPType::get<bke::GeometrySet>();
+  int64_t size = 0;
+  for (const int i : fn.inputs().index_range()) {
+    if (*fn.inputs()[i].type != geometry_type) {
+      continue;
+    }
+    if (const auto *geometry = params.try_get_input_data_ptr<bke::GeometrySet>(i)) {
+      size += geometry_size(*geometry);
+    }
+  }
+  return size;
+}
+
+ScopedNodeExecution::ScopedNodeExecution(const bNode &node,
+                                         const char *kind,
+                                         const lf::LazyFunction &fn,
+                                         const lf::Params &params)
+{
+  if (!is_enabled()) {
+    return;
+  }
+  node_ = &node;
+  kind_ = kind;
+  input_geometry_size_ = compute_input_geometry_size(fn, params);
+  memory_before_ = int64_t(MEM_get_memory_in_use());
+  get_peak_memory_tracker().begin(memory_peak_);
+  start_ = geo_eval_log::Clock::now();
+}
+
+ScopedNodeExecution::~ScopedNodeExecution()
+{
+  if (node_ == nullptr) {
+    return;
+  }
+  const TimePoint end = geo_eval_log::Clock::now();
+  get_peak_memory_tracker().end(memory_peak_);
+  record_node_execution({node_->owner_tree().id.name + 2,
+                         node_->name,
+                         node_->identifier,
+                         kind_,
+                         start_,
+                         end,
+                         memory_peak_,
+                         int64_t(MEM_get_memory_in_use()) - memory_before_,
+                         input_geometry_size_});
+}
+
+static double duration_us(const TimePoint start, const TimePoint end)
+{
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+bool write_chrome_trace(const StringRefNull filepath)
+{
+  chrome_trace::ThreadEventBuffers<NodeExecutionEvent> &events = get_events();
+
+  std::optional<TimePoint> first_start;
+  events.foreach_event([&](const int /*thread_index*/, const NodeExecutionEvent &event) {
+    if (!first_start || event.start < *first_start) {
+      first_start = event.start;
+    }
+  });
+
+  chrome_trace::TraceWriter writer;
+  events.foreach_event([&](const int thread_index, const NodeExecutionEvent &event) {
+    const double start_us = duration_us(*first_start, event.start);
+    const double end_us = duration_us(*first_start, event.end);
+    io::serialize::DictionaryValue &args = writer.add_complete_event(
+        event.node_name, event.tree_name, thread_index, start_us, end_us - start_us);
+    args.append_str("kind", event.kind);
+    args.append_int("node_id", event.node_id);
+    args.append_int("memory_peak", event.memory_peak);
+    args.append_int("memory_delta", event.memory_delta);
+    args.append_int("input_geometry_size", event.input_geometry_size);
+    writer.add_counter_event("Memory Peak", end_us, "peak", event.memory_peak);
+  });
+  return writer.write(filepath);
+}
+
+/** Print how well the evaluation made use of the available threads. */
+static void print_summary(const StringRefNull filepath)
+{
+  int64_t events_num = 0;
+  int threads_num = 0;
+  double busy_us = 0.0;
+  std::optional<TimePoint> first_start;
+  std::optional<TimePoint> last_end;
+  get_events().foreach_event([&](const int thread_index, const NodeExecutionEvent &event) {
+    events_num++;
+    threads_num = std::max(threads_num, thread_index + 1);
+    /* Nested executions are counted as part of the group or zone that contains them. */
+    if (STREQ(event.kind, "Node")) {
+      busy_us += duration_us(event.start, event.end);
+    }
+    if (!first_start || event.start < *first_start) {
+      first_start = event.start;
+    }
+    if (!last_end || event.end > *last_end) {
+      last_end = event.end;
+    }
+  });
+  const double span_us = std::max(duration_us(*first_start, *last_end), 1.0);
+  printf("Geometry nodes profile: %lld node executions on %d threads, average parallelism %.2f\n",
+         (long long)events_num,
+         threads_num,
+         busy_us / span_us);
+  printf("Geometry nodes profile written to \"%s\"\n", filepath.c_str());
+}
+
+void exit()
+{
+  chrome_trace::ThreadEventBuffers<NodeExecutionEvent> &events = get_events();
+  if (!events.is_empty()) {
+    char filepath[FILE_MAX];
+    BLI_path_join(filepath, sizeof(filepath), BKE_tempdir_base(), "geometry_nodes_profile.json");
+    if (write_chrome_trace(filepath)) {
+      print_summary(filepath);
+    }
+    else {
+      fprintf(stderr, "Geometry nodes profile could not be written to \"%s\"\n", filepath);
+    }
+  }
+  events.clear_and_shrink();
+}
+
+}  // namespace blender::nodes::geo_eval_profile
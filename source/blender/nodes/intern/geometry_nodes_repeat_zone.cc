@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_profile.hh"
 
 #include "BKE_compute_contexts.hh"
 #include "BKE_node_runtime.hh"
@@ -20,6 +21,28 @@ namespace blender::nodes {
 
 using bke::SocketValueVariant;
 
+/**
+ * Repeat zones with at least this many iterations are evaluated by calling the loop body once per
+ * iteration instead of building a graph that contains the loop body for every iteration.
+ *
+ * The unrolled graph has a node for every iteration, and building it and allocating the state of
+ * all its sockets is single-threaded work that grows linearly with the number of iterations. What
+ * it gains in return is laziness (inputs that no iteration uses are never computed) and overlap of
+ * independent parts of consecutive iterations. Both matter most for short loops that e.g. process
+ * a list of items, which rarely have more than a few hundred iterations. Loops with thousands of
+ * iterations are typically solvers where every iteration depends on the geometry of the previous
+ * one, so there is little overlap to lose, while the unrolled graph would have thousands of nodes.
+ * The threshold is placed between these two kinds of use cases.
+ */
+static constexpr int sequential_evaluation_min_iterations = 1000;
+
+/**
+ * Used for the output usage inputs of all but the last iteration, because the outputs of one
+ * iteration are always used by the next one. Not const, because lazy-function inputs are passed
+ * as mutable pointers, but it is never modified.
+ */
+static bool static_true = true;
+
 /**
  * Wraps the execution of a repeat loop body. The purpose is to setup the correct #ComputeContext
  * inside of the loop body. This is necessary to support correct logging inside of a repeat zone.
@@ -154,6 +177,8 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     const NodeGeometryRepeatOutput &node_storage = *static_cast<const NodeGeometryRepeatOutput *>(
         repeat_output_bnode_.storage);
     RepeatEvalStorage &eval_storage = *static_cast<RepeatEvalStorage *>(context.storage);
+    const geo_eval_profile::ScopedNodeExecution profile_scope{
+        repeat_output_bnode_, "Repeat Zone", *this, params};
 
     const int iterations_usage_index = zone_info_.indices.outputs.input_usages[0];
     if (!params.output_was_set(iterations_usage_index)) {
@@ -162,9 +187,16 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     }
 
     if (!eval_storage.graph_executor) {
+      /* Number of iterations to evaluate. */
+      const int iterations = std::max<int>(
+          0, params.get_input<SocketValueVariant>(zone_info_.indices.inputs.main[0]).get<int>());
+      if (iterations >= sequential_evaluation_min_iterations) {
+        this->execute_sequentially(params, context, node_storage, iterations);
+        return;
+      }
       /* Create the execution graph in the first evaluation. */
       this->initialize_execution_graph(
-          params, eval_storage, node_storage, user_data, local_user_data);
+          eval_storage, node_storage, iterations, user_data, local_user_data);
     }
 
     /* Execute the graph for the repeat zone. */
@@ -186,20 +218,12 @@ class LazyFunctionForRepeatZone : public LazyFunction {
    * graph than to execute it (for intended use cases of this generic implementation, more special
    * case repeat loop evaluations could be implemented separately).
    */
-  void initialize_execution_graph(lf::Params &params,
-                                  RepeatEvalStorage &eval_storage,
-                                  const NodeGeometryRepeatOutput &node_storage,
-                                  GeoNodesLFUserData &user_data,
-                                  GeoNodesLFLocalUserData &local_user_data) const
+  /** Show a warning when the inspection index is out of range. */
+  void log_inspection_index_warning(const NodeGeometryRepeatOutput &node_storage,
+                                    const int iterations,
+                                    GeoNodesLFUserData &user_data,
+                                    GeoNodesLFLocalUserData &local_user_data) const
   {
-    const int num_repeat_items = node_storage.items_num;
-    const int num_border_links = body_fn_.indices.inputs.border_links.size();
-
-    /* Number of iterations to evaluate. */
-    const int iterations = std::max<int>(
-        0, params.get_input<SocketValueVariant>(zone_info_.indices.inputs.main[0]).get<int>());
-
-    /* Show a warning when the inspection index is out of range. */
     if (node_storage.inspection_index > 0) {
       if (node_storage.inspection_index >= iterations) {
         if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
@@ -212,6 +236,189 @@ class LazyFunctionForRepeatZone : public LazyFunction {
         }
       }
     }
+  }
+
+  /**
+   * Evaluate the loop body once per iteration, passing the outputs of one iteration directly to
+   * the next one. Compared to #initialize_execution_graph, this avoids creating and scheduling a
+   * graph whose size depends on the number of iterations, and the state of the body evaluation is
+   * set up only once and reset between iterations.
+   *
+   * The downsides are that consecutive iterations can't overlap, and that the zone is not lazy
+   * with respect to its inputs: which inputs the body uses is only known while evaluating it, so
+   * every input of the zone is requested and computed before the first iteration, even if no
+   * iteration ends up using it.
+   */
+  void execute_sequentially(lf::Params &params,
+                            const lf::Context &context,
+                            const NodeGeometryRepeatOutput &node_storage,
+                            const int iterations) const
+  {
+    auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+    auto &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(context.local_user_data);
+
+    const int num_repeat_items = node_storage.items_num;
+    const int num_border_links = body_fn_.indices.inputs.border_links.size();
+    const ZoneFunctionIndices &zone_indices = zone_info_.indices;
+    const ZoneFunctionIndices &body_indices = body_fn_.indices;
+
+    /* Every input may be used by some iteration, the body is not evaluated lazily. */
+    for (const int i : IndexRange(num_repeat_items)) {
+      const int usage_index = zone_indices.outputs.input_usages[i + 1];
+      if (!params.output_was_set(usage_index)) {
+        params.set_output(usage_index, true);
+      }
+    }
+    for (const int i : IndexRange(num_border_links)) {
+      const int usage_index = zone_indices.outputs.border_link_usages[i];
+      if (!params.output_was_set(usage_index)) {
+        params.set_output(usage_index, true);
+      }
+    }
+    bool all_inputs_available = true;
+    for (const int i : inputs_.index_range().drop_front(1)) {
+      if (params.try_get_input_data_ptr_or_request(i) == nullptr) {
+        all_inputs_available = false;
+      }
+    }
+    if (!all_inputs_available) {
+      /* Wait until all inputs are computed. */
+      return;
+    }
+
+    this->log_inspection_index_warning(node_storage, iterations, user_data, local_user_data);
+
+    const LazyFunction &body_fn = *body_fn_.function;
+    const int body_inputs_num = body_fn.inputs().size();
+    const int body_outputs_num = body_fn.outputs().size();
+
+    LinearAllocator<> allocator;
+    auto allocate_value = [&](const CPPType &type) -> GMutablePointer {
+      return {type, allocator.allocate(type.size(), type.alignment())};
+    };
+
+    /* Values that are passed from one iteration to the next. */
+    Array<GMutablePointer> item_values(num_repeat_items);
+    for (const int i : IndexRange(num_repeat_items)) {
+      const int input_index = zone_indices.inputs.main[i + 1];
+      const CPPType &type = *inputs_[input_index].type;
+      item_values[i] = allocate_value(type);
+      type.move_construct(params.try_get_input_data_ptr(input_index), item_values[i].get());
+    }
+    Array<bool> output_usages(num_repeat_items);
+    for (const int i : IndexRange(num_repeat_items)) {
+      output_usages[i] = params.get_input<bool>(zone_indices.inputs.output_usages[i]);
+    }
+
+    /* Inputs that are the same for every iteration. Since the loop body may take ownership of its
+     * inputs, every iteration gets a copy. */
+    Vector<std::pair<int, int>> constant_inputs;
+    for (const int i : IndexRange(num_border_links)) {
+      constant_inputs.append(
+          {zone_indices.inputs.border_links[i], body_indices.inputs.border_links[i]});
+    }
+    for (const auto &item : body_indices.inputs.reference_sets.items()) {
+      constant_inputs.append({zone_indices.inputs.reference_sets.lookup(item.key), item.value});
+    }
+
+    Array<GMutablePointer> body_inputs(body_inputs_num);
+    Array<GMutablePointer> body_outputs(body_outputs_num);
+    Array<std::optional<lf::ValueUsage>> body_input_usages(body_inputs_num);
+    Array<lf::ValueUsage> body_output_usages(body_outputs_num, lf::ValueUsage::Unused);
+    Array<bool> body_set_outputs(body_outputs_num);
+    for (const int i : IndexRange(body_outputs_num)) {
+      body_outputs[i] = allocate_value(*body_fn.outputs()[i].type);
+    }
+    for (const int i : IndexRange(num_repeat_items)) {
+      body_output_usages[body_indices.outputs.main[i]] = lf::ValueUsage::Used;
+    }
+    for (const auto &[zone_index, body_index] : constant_inputs) {
+      body_inputs[body_index] = allocate_value(*inputs_[zone_index].type);
+    }
+
+    const bool use_index_values = zone_.input_node->output_socket(0).is_directly_linked();
+
+    /* The storage of the body function (its graph executor state) is reused for all iterations. */
+    LinearAllocator<> body_allocator;
+    void *body_storage = body_fn.init_storage(body_allocator);
+    BLI_SCOPED_DEFER([&]() { body_fn.destruct_storage(body_storage); });
+
+    for (const int iteration : IndexRange(iterations)) {
+      if (iteration > 0) {
+        body_fn.reset_storage(body_storage);
+      }
+
+      SocketValueVariant index_value{use_index_values ? iteration : -1};
+      body_inputs[body_indices.inputs.main[0]] = &index_value;
+      for (const int i : IndexRange(num_repeat_items)) {
+        body_inputs[body_indices.inputs.main[i + 1]] = item_values[i];
+        body_inputs[body_indices.inputs.output_usages[i]] = iteration == iterations - 1 ?
+                                                                &output_usages[i] :
+                                                                &static_true;
+      }
+      for (const auto &[zone_index, body_index] : constant_inputs) {
+        const GMutablePointer value = body_inputs[body_index];
+        value.type()->copy_construct(params.try_get_input_data_ptr(zone_index), value.get());
+      }
+      body_input_usages.fill(std::nullopt);
+      body_set_outputs.fill(false);
+
+      /* Setup context for the loop body evaluation. */
+      bke::RepeatZoneComputeContext body_compute_context{
+          user_data.compute_context, repeat_output_bnode_, iteration};
+      GeoNodesLFUserData body_user_data = user_data;
+      body_user_data.compute_context = &body_compute_context;
+      body_user_data.log_socket_values = should_log_socket_values_for_context(
+          user_data, body_compute_context.hash());
+      GeoNodesLFLocalUserData body_local_user_data{body_user_data};
+
+      lf::Context body_context{body_storage, &body_user_data, &body_local_user_data};
+      lf::BasicParams body_params{body_fn,
+                                  body_inputs,
+                                  body_outputs,
+                                  body_input_usages,
+                                  body_output_usages,
+                                  body_set_outputs};
+      {
+        ScopedComputeContextTimer timer(body_context);
+        body_fn.execute(body_params, body_context);
+      }
+
+      for (const auto &[zone_index, body_index] : constant_inputs) {
+        body_inputs[body_index].destruct();
+      }
+      /* Pass the outputs of this iteration to the next one. */
+      for (const int i : IndexRange(num_repeat_items)) {
+        GMutablePointer &body_output = body_outputs[body_indices.outputs.main[i]];
+        BLI_assert(body_set_outputs[body_indices.outputs.main[i]]);
+        item_values[i].destruct();
+        body_output.type()->relocate_construct(body_output.get(), item_values[i].get());
+      }
+      for (const int i : IndexRange(body_outputs_num)) {
+        if (body_set_outputs[i] && body_output_usages[i] == lf::ValueUsage::Unused) {
+          body_outputs[i].destruct();
+        }
+      }
+    }
+
+    for (const int i : IndexRange(num_repeat_items)) {
+      const int output_index = zone_indices.outputs.main[i];
+      item_values[i].type()->relocate_construct(item_values[i].get(),
+                                                params.get_output_data_ptr(output_index));
+      params.output_set(output_index);
+    }
+  }
+
+  void initialize_execution_graph(RepeatEvalStorage &eval_storage,
+                                  const NodeGeometryRepeatOutput &node_storage,
+                                  const int iterations,
+                                  GeoNodesLFUserData &user_data,
+                                  GeoNodesLFLocalUserData &local_user_data) const
+  {
+    const int num_repeat_items = node_storage.items_num;
+    const int num_border_links = body_fn_.indices.inputs.border_links.size();
+
+    this->log_inspection_index_warning(node_storage, iterations, user_data, local_user_data);
 
     /* Take iterations input into account. */
     const int main_inputs_offset = 1;
@@ -280,8 +487,6 @@ class LazyFunctionForRepeatZone : public LazyFunction {
       }
     }
 
-    static bool static_true = true;
-
     /* Handle body nodes pair-wise. */
     for (const int iter_i : lf_body_nodes.index_range().drop_back(1)) {
       lf::FunctionNode &lf_node = *lf_body_nodes[iter_i];
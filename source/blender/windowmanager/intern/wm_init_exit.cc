@@ -114,6 +114,8 @@
 
 #include "DRW_engine.hh"
 
+#include "NOD_geometry_nodes_profile.hh"
+
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_OPERATORS, "wm.operator");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_HANDLERS, "wm.handler");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_EVENTS, "wm.event");
@@ -569,6 +571,10 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
 
   BKE_mball_cubeTable_free();
 
+  if (G.debug & G_DEBUG_GEOMETRY_NODES_PROFILE) {
+    nodes::geo_eval_profile::exit();
+  }
+
   /* Render code might still access databases. */
   RE_FreeAllRender();
   RE_engines_exit();
@@ -0,0 +1,101 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True)
+    scene = bpy.context.scene
+    mesh = bpy.data.meshes.new("Grid")
+    mesh.from_pydata([(x, y, 0.0) for y in range(8) for x in range(8)], [],
+                     [(y * 8 + x, y * 8 + x + 1, y * 8 + x + 9, y * 8 + x + 8)
+                      for y in range(7) for x in range(7)])
+
+    # Many independent objects with a cheap modifier stack, which results in a wide graph.
+    for i in range(args['wide_objects_num']):
+        ob = bpy.data.objects.new(f"Wide {i}", mesh)
+        ob.location = (i % 64, i // 64, 0.0)
+        ob.modifiers.new("Subdivision", 'SUBSURF').levels = 1
+        ob.modifiers.new("Displace", 'DISPLACE')
+        scene.collection.objects.link(ob)
+
+    # Objects whose geometry depends on the previous object, which results in a long critical path
+    # next to the wide part of the graph.
+    previous_ob = None
+    for i in range(args['chain_objects_num']):
+        ob = bpy.data.objects.new(f"Chain {i}", mesh)
+        ob.location = (0.0, 0.0, i + 1.0)
+        ob.modifiers.new("Subdivision", 'SUBSURF').levels = 2
+        if previous_ob:
+            ob.modifiers.new("Shrinkwrap", 'SHRINKWRAP').target = previous_ob
+        scene.collection.objects.link(ob)
+        previous_ob = ob
+
+
+def _run(args):
+    import bpy
+    import time
+
+    _create_scene(args)
+    # Evaluate objects once first, to avoid any possible lazy evaluation later.
+    bpy.context.view_layer.update()
+
+    test_time_start = time.time()
+    measured_times = []
+
+    min_measurements = 5
+    max_measurements = 100
+    timeout = 5
+
+    while True:
+        for ob in bpy.context.view_layer.objects:
+            ob.update_tag(refresh={'DATA'})
+
+        start_time = time.time()
+        bpy.context.view_layer.update()
+        elapsed_time = time.time() - start_time
+        measured_times.append(elapsed_time)
+
+        if len(measured_times) >= min_measurements and test_time_start + timeout < time.time():
+            break
+        if len(measured_times) >= max_measurements:
+            break
+
+    average_time = sum(measured_times) / len(measured_times)
+    result = {'time': average_time}
+    return result
+
+
+# Generated scenes, to measure how well the depsgraph scheduling uses the available threads for
+# graphs of different shapes.
+class DepsgraphEvaluationTest(api.Test):
+    def __init__(self, name, wide_objects_num, chain_objects_num):
+        self._name = name
+        self.wide_objects_num = wide_objects_num
+        self.chain_objects_num = chain_objects_num
+
+    def name(self):
+        return self._name
+
+    def category(self):
+        return "depsgraph"
+
+    def run(self, env, device_id):
+        args = {
+            'wide_objects_num': self.wide_objects_num,
+            'chain_objects_num': self.chain_objects_num,
+        }
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [
+        DepsgraphEvaluationTest("wide", 4096, 0),
+        DepsgraphEvaluationTest("chain", 0, 64),
+        DepsgraphEvaluationTest("wide_and_chain", 4096, 64),
+    ]